@@ -0,0 +1,43 @@
+#include "Sarah/SarahAnimationSharingSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+
+USkeletalMeshComponent* USarahAnimationSharingSubsystem::AcquireLeader(ESarahMovementState State, UAnimSequence* Sequence, USkeletalMesh* Mesh, int32 PhaseBucket, int32 NumPhaseBuckets)
+{
+    if (!Sequence || !Mesh) return nullptr;
+
+    const FLeaderKey Key { State, Sequence, Mesh, PhaseBucket };
+    if (USkeletalMeshComponent* Existing = Leaders.FindRef(Key).Get())
+    {
+        return Existing;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World) return nullptr;
+
+    if (!LeaderActor)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        LeaderActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!LeaderActor) return nullptr;
+    }
+
+    USkeletalMeshComponent* Leader = NewObject<USkeletalMeshComponent>(LeaderActor, NAME_None, RF_Transient);
+    Leader->SetSkeletalMesh(Mesh);
+    Leader->SetHiddenInGame(true);
+    Leader->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+    // Hidden, so force the pose to keep evaluating for the followers
+    Leader->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+    Leader->RegisterComponent();
+
+    Leader->PlayAnimation(Sequence, true);
+    const float PhaseFraction = NumPhaseBuckets > 0 ? static_cast<float>(PhaseBucket) / NumPhaseBuckets : 0.0f;
+    Leader->SetPosition(Sequence->GetPlayLength() * PhaseFraction, false);
+
+    LeaderComponents.Add(Leader);
+    Leaders.Add(Key, Leader);
+    return Leader;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Sarah/SarahCharacter.h"
+#include "SarahAnimationSharingSubsystem.generated.h"
+
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+// Leader meshes that evaluate the looping locomotion states once for the whole
+// crowd. Followers copy a leader's pose; each state has several leaders started
+// at different phases so followers do not all move in lockstep.
+UCLASS()
+class SARAH_API USarahAnimationSharingSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Returns a leader playing Sequence for State at PhaseBucket of NumPhaseBuckets
+    USkeletalMeshComponent* AcquireLeader(ESarahMovementState State, UAnimSequence* Sequence, USkeletalMesh* Mesh, int32 PhaseBucket, int32 NumPhaseBuckets);
+
+private:
+    struct FLeaderKey
+    {
+        ESarahMovementState State;
+        const UAnimSequence* Sequence;
+        const USkeletalMesh* Mesh;
+        int32 PhaseBucket;
+
+        bool operator==(const FLeaderKey& Other) const
+        {
+            return State == Other.State && Sequence == Other.Sequence && Mesh == Other.Mesh && PhaseBucket == Other.PhaseBucket;
+        }
+
+        friend uint32 GetTypeHash(const FLeaderKey& Key)
+        {
+            uint32 Hash = HashCombine(::GetTypeHash(Key.Sequence), ::GetTypeHash(Key.Mesh));
+            return HashCombine(Hash, ::GetTypeHash(static_cast<int32>(Key.State) * 64 + Key.PhaseBucket));
+        }
+    };
+
+    UPROPERTY()
+    AActor* LeaderActor = nullptr;
+
+    UPROPERTY()
+    TArray<USkeletalMeshComponent*> LeaderComponents;
+
+    TMap<FLeaderKey, TWeakObjectPtr<USkeletalMeshComponent>> Leaders;
+};
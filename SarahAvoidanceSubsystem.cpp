@@ -0,0 +1,127 @@
+#include "Sarah/SarahAvoidanceSubsystem.h"
+#include "Sarah/SarahCharacter.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sarah Avoidance Grid Update"), STAT_SarahAvoidanceUpdate, STATGROUP_Sarah);
+DECLARE_CYCLE_STAT(TEXT("Sarah Avoidance Query"), STAT_SarahAvoidanceQuery, STATGROUP_Sarah);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sarah Avoidance Agents"), STAT_SarahAvoidanceAgents, STATGROUP_Sarah);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sarah Avoidance Cell Changes"), STAT_SarahAvoidanceCellChanges, STATGROUP_Sarah);
+
+static TAutoConsoleVariable<float> CVarSarahAvoidanceCellSize(
+    TEXT("sarah.Avoidance.CellSize"),
+    200.0f,
+    TEXT("Cell size of the Sarah avoidance grid in cm. Avoidance radii are clamped to it. Read when a world starts."),
+    ECVF_Default);
+
+void USarahAvoidanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    CellSize = FMath::Max(CVarSarahAvoidanceCellSize.GetValueOnGameThread(), 10.0f);
+}
+
+int32 USarahAvoidanceSubsystem::RegisterAgent(const FVector& Location)
+{
+    const int32 Handle = FreeHandles.Num() > 0 ? FreeHandles.Pop(false) : Agents.AddDefaulted();
+
+    FAgent& Agent = Agents[Handle];
+    Agent.Location = FVector2D(Location);
+    Agent.bActive = true;
+    AddToCell(Handle, GetCell(Agent.Location));
+    return Handle;
+}
+
+void USarahAvoidanceSubsystem::UnregisterAgent(int32 Handle)
+{
+    if (!Agents.IsValidIndex(Handle) || !Agents[Handle].bActive) return;
+
+    RemoveFromCell(Handle);
+    Agents[Handle] = FAgent();
+    FreeHandles.Add(Handle);
+}
+
+void USarahAvoidanceSubsystem::UpdateAgent(int32 Handle, const FVector& Location)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SarahAvoidanceUpdate);
+
+    if (!Agents.IsValidIndex(Handle) || !Agents[Handle].bActive) return;
+
+    FAgent& Agent = Agents[Handle];
+    Agent.Location = FVector2D(Location);
+
+    // Only agents that crossed a cell boundary touch the grid
+    const FIntPoint NewCell = GetCell(Agent.Location);
+    if (NewCell != Agent.Cell)
+    {
+        RemoveFromCell(Handle);
+        AddToCell(Handle, NewCell);
+        INC_DWORD_STAT(STAT_SarahAvoidanceCellChanges);
+    }
+}
+
+FVector2D USarahAvoidanceSubsystem::ComputeSeparation(int32 Handle, float Radius) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SarahAvoidanceQuery);
+
+    if (!Agents.IsValidIndex(Handle) || !Agents[Handle].bActive) return FVector2D::ZeroVector;
+
+    const FAgent& Self = Agents[Handle];
+    const float ClampedRadius = FMath::Min(Radius, CellSize);
+    const float RadiusSq = FMath::Square(ClampedRadius);
+
+    FVector2D Separation = FVector2D::ZeroVector;
+    for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+    {
+        for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+        {
+            const TArray<int32>* Cell = Cells.Find(Self.Cell + FIntPoint(OffsetX, OffsetY));
+            if (!Cell) continue;
+
+            for (const int32 OtherHandle : *Cell)
+            {
+                if (OtherHandle == Handle) continue;
+
+                const FVector2D Away = Self.Location - Agents[OtherHandle].Location;
+                const float DistanceSq = Away.SizeSquared();
+                if (DistanceSq >= RadiusSq || DistanceSq < KINDA_SMALL_NUMBER) continue;
+
+                const float Distance = FMath::Sqrt(DistanceSq);
+                Separation += (Away / Distance) * (1.0f - Distance / ClampedRadius);
+            }
+        }
+    }
+
+    return Separation;
+}
+
+FIntPoint USarahAvoidanceSubsystem::GetCell(const FVector2D& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void USarahAvoidanceSubsystem::AddToCell(int32 Handle, const FIntPoint& Cell)
+{
+    TArray<int32>& Bucket = Cells.FindOrAdd(Cell);
+    Agents[Handle].Cell = Cell;
+    Agents[Handle].SlotInCell = Bucket.Add(Handle);
+    INC_DWORD_STAT(STAT_SarahAvoidanceAgents);
+}
+
+void USarahAvoidanceSubsystem::RemoveFromCell(int32 Handle)
+{
+    FAgent& Agent = Agents[Handle];
+    TArray<int32>* Bucket = Cells.Find(Agent.Cell);
+    if (!Bucket || !Bucket->IsValidIndex(Agent.SlotInCell)) return;
+
+    // Swap-remove and fix up the moved agent's slot
+    const int32 Slot = Agent.SlotInCell;
+    Bucket->RemoveAtSwap(Slot, 1, false);
+    if (Bucket->IsValidIndex(Slot))
+    {
+        Agents[(*Bucket)[Slot]].SlotInCell = Slot;
+    }
+
+    // Keep the bucket allocation around; crowds tend to revisit the same cells
+    Agent.SlotInCell = INDEX_NONE;
+    DEC_DWORD_STAT(STAT_SarahAvoidanceAgents);
+}
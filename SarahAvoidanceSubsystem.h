@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SarahAvoidanceSubsystem.generated.h"
+
+// Uniform-grid spatial hash of Sarah positions for cheap local avoidance.
+// Agents move between cells incrementally as they update; queries only
+// visit the 3x3 block of cells around the querying agent.
+UCLASS()
+class SARAH_API USarahAvoidanceSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    int32 RegisterAgent(const FVector& Location);
+    void UnregisterAgent(int32 Handle);
+    void UpdateAgent(int32 Handle, const FVector& Location);
+
+    // Sum of push-away vectors from neighbors inside Radius, weighted by proximity
+    FVector2D ComputeSeparation(int32 Handle, float Radius) const;
+
+    float GetCellSize() const { return CellSize; }
+
+private:
+    struct FAgent
+    {
+        FVector2D Location = FVector2D::ZeroVector;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+        int32 SlotInCell = INDEX_NONE;
+        bool bActive = false;
+    };
+
+    FIntPoint GetCell(const FVector2D& Location) const;
+    void AddToCell(int32 Handle, const FIntPoint& Cell);
+    void RemoveFromCell(int32 Handle);
+
+    float CellSize = 200.0f;
+
+    TArray<FAgent> Agents;
+    TArray<int32> FreeHandles;
+    TMap<FIntPoint, TArray<int32>> Cells;
+};
@@ -0,0 +1,52 @@
+#include "Sarah/SarahAvoidanceSubsystem.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSarahAvoidanceGridTest, "Sarah.Avoidance.SpatialHash",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSarahAvoidanceGridTest::RunTest(const FString& Parameters)
+{
+    // Default 200cm cells; the grid itself never touches the world
+    USarahAvoidanceSubsystem* Grid = NewObject<USarahAvoidanceSubsystem>();
+    const float Radius = 100.0f;
+
+    const int32 A = Grid->RegisterAgent(FVector(150.0f, 50.0f, 0.0f));
+    const int32 B = Grid->RegisterAgent(FVector(210.0f, 50.0f, 0.0f));
+
+    // Neighbours in adjacent cells are found, pushed apart along the line between them
+    const FVector2D SeparationA = Grid->ComputeSeparation(A, Radius);
+    TestEqual(TEXT("A is pushed towards -X"), SeparationA.X, -0.4f, 1e-4f);
+    TestEqual(TEXT("No sideways push"), SeparationA.Y, 0.0f, 1e-4f);
+    TestEqual(TEXT("Separation is symmetric"), Grid->ComputeSeparation(B, Radius).X, 0.4f, 1e-4f);
+
+    // Leaving the radius, then the 3x3 block, drops the neighbour
+    Grid->UpdateAgent(B, FVector(260.0f, 50.0f, 0.0f));
+    TestTrue(TEXT("Outside the radius"), Grid->ComputeSeparation(A, Radius).IsZero());
+    Grid->UpdateAgent(B, FVector(1000.0f, 1000.0f, 0.0f));
+    TestTrue(TEXT("Several cells away"), Grid->ComputeSeparation(A, Radius).IsZero());
+    Grid->UpdateAgent(B, FVector(150.0f, 100.0f, 0.0f));
+    TestEqual(TEXT("Back next to A"), Grid->ComputeSeparation(A, Radius).Y, -0.5f, 1e-4f);
+
+    // Radii larger than a cell are clamped so the 3x3 query stays complete
+    Grid->UpdateAgent(B, FVector(150.0f, 240.0f, 0.0f));
+    TestTrue(TEXT("Radius clamped to the cell size"), Grid->ComputeSeparation(A, 1000.0f).Y < 0.0f);
+    Grid->UpdateAgent(B, FVector(150.0f, 260.0f, 0.0f));
+    TestTrue(TEXT("Nothing past the clamped radius"), Grid->ComputeSeparation(A, 1000.0f).IsZero());
+
+    // Swap-removal keeps the remaining agents of a cell queryable
+    Grid->UpdateAgent(B, FVector(150.0f, 100.0f, 0.0f));
+    const int32 C = Grid->RegisterAgent(FVector(100.0f, 50.0f, 0.0f));
+    Grid->UnregisterAgent(A);
+    TestEqual(TEXT("C still sees B"), Grid->ComputeSeparation(C, Radius).Y, -(1.0f - FMath::Sqrt(2.0f) * 50.0f / Radius) * FMath::Sqrt(0.5f), 1e-4f);
+    TestTrue(TEXT("Unregistered handles report nothing"), Grid->ComputeSeparation(A, Radius).IsZero());
+
+    // Freed handles are reused
+    const int32 D = Grid->RegisterAgent(FVector(100.0f, 0.0f, 0.0f));
+    TestEqual(TEXT("Handle reused"), D, A);
+    TestEqual(TEXT("D pushed away from C"), Grid->ComputeSeparation(D, Radius).Y, -0.5f, 1e-4f);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -1,14 +1,41 @@
 #include "Sarah/SarahCharacter.h"
+#include "Sarah/SarahStateTelemetry.h"
+#include "Sarah/SarahAvoidanceSubsystem.h"
+#include "Sarah/SarahMovementComponent.h"
+#include "Sarah/SarahAnimationSharingSubsystem.h"
+#include "Sarah/SarahPoseDatabase.h"
+#include "Sarah/SarahSpringArmComponent.h"
+#include "Sarah/SarahStateEventSubsystem.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 
-ASarahCharacter::ASarahCharacter()
+DECLARE_CYCLE_STAT(TEXT("Sarah Tick"), STAT_SarahTick, STATGROUP_Sarah);
+DECLARE_CYCLE_STAT(TEXT("Sarah Update Movement"), STAT_SarahUpdateMovement, STATGROUP_Sarah);
+DECLARE_CYCLE_STAT(TEXT("Sarah Update State Machine"), STAT_SarahUpdateStateMachine, STATGROUP_Sarah);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sarah Budgeted Meshes"), STAT_SarahBudgetedMeshes, STATGROUP_Sarah);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Sarah Anim Budget (ms)"), STAT_SarahAnimBudgetMs, STATGROUP_Sarah);
+
+// Changes only on BeginPlay/EndPlay, so per-frame walks over it never allocate
+static TArray<ASarahCharacter*> ActiveSarahs;
+
+// Summed over all Sarahs, for the tick budget test
+static uint64 MovementUpdateCycles = 0;
+
+ASarahCharacter::ASarahCharacter(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer
+        .SetDefaultSubobjectClass<USarahMovementComponent>(ACharacter::CharacterMovementComponentName)
+        .SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
     PrimaryActorTick.bCanEverTick = true;
 
@@ -23,6 +50,18 @@ ASarahCharacter::ASarahCharacter()
     CurrentMovementAngle = 0.0f;
     TargetMovementAngle = 0.0f;
     bIsTransitioningAngle = false;
+    AvoidanceYawOffset = 0.0f;
+    AvoidanceAgentHandle = INDEX_NONE;
+
+    // Initialize fixed-step simulation state
+    SimulationAccumulator = 0.0f;
+    SimulatedYaw = 0.0f;
+    PreviousSimulatedYaw = 0.0f;
+    bHasSimulatedRotation = false;
+
+    // Initialize snapshot history
+    SnapshotHistoryHead = 0;
+    SnapshotHistoryCount = 0;
 
     // Initialize jump state
     bJumpStartCompleted = false;
@@ -31,6 +70,24 @@ ASarahCharacter::ASarahCharacter()
     JumpAnimationLength = 0.0f;
     PreviousZVelocity = 0.0f;
 
+    // Initialize pose matching
+    LastPoseMatchAngle = 0.0f;
+    bPlayingMatchedTransition = false;
+
+    // Initialize animation budget: airborne states matter most, idle least
+    bRegisteredWithAnimationBudget = false;
+    AnimationStateSignificance.Add(ESarahMovementState::Idle, 0.25f);
+    AnimationStateSignificance.Add(ESarahMovementState::Walk, 0.5f);
+    AnimationStateSignificance.Add(ESarahMovementState::Run, 0.6f);
+    AnimationStateSignificance.Add(ESarahMovementState::Jump, 1.0f);
+    AnimationStateSignificance.Add(ESarahMovementState::Landing, 1.0f);
+
+    // Registration is decided by bUseAnimationBudget in BeginPlay, not by the component
+    if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+    {
+        BudgetedMesh->SetAutoRegisterWithBudgetAllocator(false);
+    }
+
     // Initialize landing state
     LandingStartTime = 0.0f;
     LandingAnimationLength = 0.0f;
@@ -40,31 +97,52 @@ ASarahCharacter::ASarahCharacter()
     // Setup character capsule collision
     GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
 
-    // Load character mesh
-    static ConstructorHelpers::FObjectFinder<USkeletalMesh> SkeletalMeshFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Mesh/SK_Sarah"));
-    if (SkeletalMeshFinder.Succeeded())
+    // Dedicated servers skip camera, mesh, animation and input assets entirely
+    bIsLeanServer = IsRunningDedicatedServer();
+
+    if (!bIsLeanServer)
     {
-        GetMesh()->SetSkeletalMesh(SkeletalMeshFinder.Object);
-        GetMesh()->SetAnimInstanceClass(nullptr);
+        // Load character mesh
+        static ConstructorHelpers::FObjectFinder<USkeletalMesh> SkeletalMeshFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Mesh/SK_Sarah"));
+        if (SkeletalMeshFinder.Succeeded())
+        {
+            GetMesh()->SetSkeletalMesh(SkeletalMeshFinder.Object);
+            GetMesh()->SetAnimInstanceClass(nullptr);
+        }
     }
 
     // Position mesh relative to capsule
     GetMesh()->SetRelativeLocation(FVector(0.0f, 0.0f, -90.0f));
     GetMesh()->SetRelativeRotation(FRotator(0.0f, -90.0f, 0.0f));
 
-    // Create camera boom (spring arm)
-    CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
-    CameraBoom->SetupAttachment(RootComponent);
-    CameraBoom->TargetArmLength = 400.0f;
-    CameraBoom->bUsePawnControlRotation = true;
-    CameraBoom->bInheritPitch = true;
-    CameraBoom->bInheritYaw = true;
-    CameraBoom->bInheritRoll = true;
+    // Created on every machine so Blueprint subclasses see the same native
+    // components everywhere; lean servers stop them ticking in BeginPlay.
+    // Optional so a subclass can drop them with DoNotCreateDefaultSubobject.
+    CameraBoom = CreateOptionalDefaultSubobject<USarahSpringArmComponent>(TEXT("CameraBoom"));
+    if (CameraBoom)
+    {
+        CameraBoom->SetupAttachment(RootComponent);
+        CameraBoom->TargetArmLength = 400.0f;
+        CameraBoom->bUsePawnControlRotation = true;
+        CameraBoom->bInheritPitch = true;
+        CameraBoom->bInheritYaw = true;
+        CameraBoom->bInheritRoll = true;
+    }
 
     // Create follow camera
-    FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
-    FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
-    FollowCamera->bUsePawnControlRotation = false;
+    FollowCamera = CreateOptionalDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
+    if (FollowCamera)
+    {
+        if (CameraBoom)
+        {
+            FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
+        }
+        else
+        {
+            FollowCamera->SetupAttachment(RootComponent);
+        }
+        FollowCamera->bUsePawnControlRotation = false;
+    }
 
     // Configure character movement
     bUseControllerRotationPitch = false;
@@ -73,86 +151,90 @@ ASarahCharacter::ASarahCharacter()
 
     if (GetCharacterMovement())
     {
-        GetCharacterMovement()->bOrientRotationToMovement = true;
-        GetCharacterMovement()->RotationRate = FRotator(0.0f, 540.0f, 0.0f);
+        // Rotation is owned by USarahMovementComponent, driven from UpdateCharacterRotation
+        GetCharacterMovement()->bOrientRotationToMovement = false;
         GetCharacterMovement()->JumpZVelocity = 300.f;
         GetCharacterMovement()->AirControl = 0.2f;
         GetCharacterMovement()->MaxWalkSpeed = WalkSpeed;
     }
 
-    // Load input assets
-    static ConstructorHelpers::FObjectFinder<UInputMappingContext> IMC_Finder(TEXT("/Game/Sarah/Inputs/IMC_Sarah"));
-    if (IMC_Finder.Succeeded())
+    if (!bIsLeanServer)
     {
-        DefaultMappingContext = IMC_Finder.Object;
-    }
+        // Load input assets
+        static ConstructorHelpers::FObjectFinder<UInputMappingContext> IMC_Finder(TEXT("/Game/Sarah/Inputs/IMC_Sarah"));
+        if (IMC_Finder.Succeeded())
+        {
+            DefaultMappingContext = IMC_Finder.Object;
+        }
 
-    static ConstructorHelpers::FObjectFinder<UInputAction> MoveAction_Finder(TEXT("/Game/Sarah/Inputs/IA_Sarah_Move"));
-    if (MoveAction_Finder.Succeeded())
-    {
-        MoveAction = MoveAction_Finder.Object;
-    }
+        static ConstructorHelpers::FObjectFinder<UInputAction> MoveAction_Finder(TEXT("/Game/Sarah/Inputs/IA_Sarah_Move"));
+        if (MoveAction_Finder.Succeeded())
+        {
+            MoveAction = MoveAction_Finder.Object;
+        }
 
-    static ConstructorHelpers::FObjectFinder<UInputAction> LookAction_Finder(TEXT("/Game/Sarah/Inputs/IA_Sarah_Look"));
-    if (LookAction_Finder.Succeeded())
-    {
-        LookAction = LookAction_Finder.Object;
-    }
+        static ConstructorHelpers::FObjectFinder<UInputAction> LookAction_Finder(TEXT("/Game/Sarah/Inputs/IA_Sarah_Look"));
+        if (LookAction_Finder.Succeeded())
+        {
+            LookAction = LookAction_Finder.Object;
+        }
 
-    static ConstructorHelpers::FObjectFinder<UInputAction> SprintAction_Finder(TEXT("/Game/Sarah/Inputs/IA_Sarah_Sprint"));
-    if (SprintAction_Finder.Succeeded())
-    {
-        SprintAction = SprintAction_Finder.Object;
-    }
+        static ConstructorHelpers::FObjectFinder<UInputAction> SprintAction_Finder(TEXT("/Game/Sarah/Inputs/IA_Sarah_Sprint"));
+        if (SprintAction_Finder.Succeeded())
+        {
+            SprintAction = SprintAction_Finder.Object;
+        }
 
-    static ConstructorHelpers::FObjectFinder<UInputAction> JumpAction_Finder(TEXT("/Game/Sarah/Inputs/IA_Sarah_Jump"));
-    if (JumpAction_Finder.Succeeded())
-    {
-        JumpAction = JumpAction_Finder.Object;
-    }
+        static ConstructorHelpers::FObjectFinder<UInputAction> JumpAction_Finder(TEXT("/Game/Sarah/Inputs/IA_Sarah_Jump"));
+        if (JumpAction_Finder.Succeeded())
+        {
+            JumpAction = JumpAction_Finder.Object;
+        }
 
-    // Load animation sequences
-    static ConstructorHelpers::FObjectFinder<UAnimSequence> IdleAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MF_Idle"));
-    if (IdleAnimFinder.Succeeded())
-    {
-        IdleAnimation = IdleAnimFinder.Object;
-    }
+        // Load animation sequences
+        static ConstructorHelpers::FObjectFinder<UAnimSequence> IdleAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MF_Idle"));
+        if (IdleAnimFinder.Succeeded())
+        {
+            IdleAnimation = IdleAnimFinder.Object;
+        }
 
-    static ConstructorHelpers::FObjectFinder<UAnimSequence> WalkAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MF_Walk_Fwd"));
-    if (WalkAnimFinder.Succeeded())
-    {
-        WalkAnimation = WalkAnimFinder.Object;
-    }
+        static ConstructorHelpers::FObjectFinder<UAnimSequence> WalkAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MF_Walk_Fwd"));
+        if (WalkAnimFinder.Succeeded())
+        {
+            WalkAnimation = WalkAnimFinder.Object;
+        }
 
-    static ConstructorHelpers::FObjectFinder<UAnimSequence> RunAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MF_Run_Fwd"));
-    if (RunAnimFinder.Succeeded())
-    {
-        RunAnimation = RunAnimFinder.Object;
-    }
+        static ConstructorHelpers::FObjectFinder<UAnimSequence> RunAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MF_Run_Fwd"));
+        if (RunAnimFinder.Succeeded())
+        {
+            RunAnimation = RunAnimFinder.Object;
+        }
 
-    static ConstructorHelpers::FObjectFinder<UAnimSequence> JumpStartAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MM_Jump"));
-    if (JumpStartAnimFinder.Succeeded())
-    {
-        JumpStartAnimation = JumpStartAnimFinder.Object;
-        if (JumpStartAnimation)
+        static ConstructorHelpers::FObjectFinder<UAnimSequence> JumpStartAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MM_Jump"));
+        if (JumpStartAnimFinder.Succeeded())
         {
-            JumpAnimationLength = JumpStartAnimation->GetPlayLength();
+            JumpStartAnimation = JumpStartAnimFinder.Object;
+            if (JumpStartAnimation)
+            {
+                JumpAnimationLength = JumpStartAnimation->GetPlayLength();
+            }
         }
-    }
 
-    static ConstructorHelpers::FObjectFinder<UAnimSequence> JumpFallAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MM_Fall_Loop"));
-    if (JumpFallAnimFinder.Succeeded())
-    {
-        JumpFallAnimation = JumpFallAnimFinder.Object;
+        static ConstructorHelpers::FObjectFinder<UAnimSequence> JumpFallAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MM_Fall_Loop"));
+        if (JumpFallAnimFinder.Succeeded())
+        {
+            JumpFallAnimation = JumpFallAnimFinder.Object;
+        }
     }
 
+    // The landing lockout is FSM timing, so servers read the clip's length too; only clients keep it to play
     static ConstructorHelpers::FObjectFinder<UAnimSequence> LandingAnimFinder(TEXT("/Game/Adventure_Pack/Characters/Sarah/Animation/AS_Sarah_MM_Land"));
-    if (LandingAnimFinder.Succeeded())
+    if (LandingAnimFinder.Succeeded() && LandingAnimFinder.Object)
     {
-        LandingAnimation = LandingAnimFinder.Object;
-        if (LandingAnimation)
+        LandingAnimationLength = LandingAnimFinder.Object->GetPlayLength();
+        if (!bIsLeanServer)
         {
-            LandingAnimationLength = LandingAnimation->GetPlayLength();
+            LandingAnimation = LandingAnimFinder.Object;
         }
     }
 }
@@ -161,6 +243,8 @@ void ASarahCharacter::BeginPlay()
 {
     Super::BeginPlay();
 
+    ActiveSarahs.Add(this);
+
     // Setup Enhanced Input system
     if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
     {
@@ -173,26 +257,227 @@ void ASarahCharacter::BeginPlay()
         }
     }
 
+    // Nobody views through the camera on a lean server, so the arm need not trace or lag
+    if (bIsLeanServer)
+    {
+        if (CameraBoom)
+        {
+            CameraBoom->SetComponentTickEnabled(false);
+        }
+        if (FollowCamera)
+        {
+            FollowCamera->SetComponentTickEnabled(false);
+        }
+    }
+
     // Initialize movement systems with current camera state
-    if (FollowCamera)
+    if (FollowCamera && !bIsLeanServer)
     {
         CurrentCameraYaw = FollowCamera->GetComponentRotation().Yaw;
         CurrentMovementAngle = CurrentCameraYaw;
         TargetMovementAngle = CurrentCameraYaw;
     }
+    else if (Controller)
+    {
+        CurrentCameraYaw = GetControlRotation().Yaw;
+        CurrentMovementAngle = CurrentCameraYaw;
+        TargetMovementAngle = CurrentCameraYaw;
+    }
+
+    SimulatedYaw = GetActorRotation().Yaw;
+    PreviousSimulatedYaw = SimulatedYaw;
+
+    // A subclass may have swapped the landing clip
+    if (LandingAnimation)
+    {
+        LandingAnimationLength = LandingAnimation->GetPlayLength();
+    }
+
+    // Join the avoidance grid
+    if (bUseLocalAvoidance)
+    {
+        if (USarahAvoidanceSubsystem* Avoidance = GetWorld()->GetSubsystem<USarahAvoidanceSubsystem>())
+        {
+            AvoidanceAgentHandle = Avoidance->RegisterAgent(GetActorLocation());
+        }
+    }
+
+    // Hand the mesh's update rate to the animation budget allocator
+    if (bUseAnimationBudget && !bIsLeanServer)
+    {
+        USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+        IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+        if (BudgetedMesh && Allocator)
+        {
+            BudgetedMesh->SetAutoCalculateSignificance(false);
+            Allocator->RegisterComponent(BudgetedMesh);
+            bRegisteredWithAnimationBudget = true;
+            UpdateAnimationBudgetSignificance();
+        }
+    }
+
+    // Allocate the snapshot ring once
+    if (SnapshotHistoryLength > 0)
+    {
+        SnapshotHistory.SetNumUninitialized(SnapshotHistoryLength);
+        SnapshotHistoryHead = 0;
+        SnapshotHistoryCount = 0;
+    }
 
     // Start in idle state
     ChangeState(ESarahMovementState::Idle);
 }
 
+void ASarahCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ActiveSarahs.RemoveSingleSwap(this, false);
+
+    if (AvoidanceAgentHandle != INDEX_NONE)
+    {
+        if (USarahAvoidanceSubsystem* Avoidance = GetWorld()->GetSubsystem<USarahAvoidanceSubsystem>())
+        {
+            Avoidance->UnregisterAgent(AvoidanceAgentHandle);
+        }
+        AvoidanceAgentHandle = INDEX_NONE;
+    }
+
+    if (bRegisteredWithAnimationBudget)
+    {
+        USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+        IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+        if (BudgetedMesh && Allocator)
+        {
+            Allocator->UnregisterComponent(BudgetedMesh);
+        }
+        bRegisteredWithAnimationBudget = false;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+const TArray<ASarahCharacter*>& ASarahCharacter::GetActiveSarahs()
+{
+    return ActiveSarahs;
+}
+
+uint64 ASarahCharacter::GetMovementUpdateCycles()
+{
+    return MovementUpdateCycles;
+}
+
+void ASarahCharacter::ResetMovementUpdateCycles()
+{
+    MovementUpdateCycles = 0;
+}
+
 void ASarahCharacter::Tick(float DeltaTime)
 {
+    SCOPE_CYCLE_COUNTER(STAT_SarahTick);
+
     Super::Tick(DeltaTime);
 
+    // Pull input from AI/crowd sources; player input arrives through the handlers
+    if (InputSource.GetInterface())
+    {
+        FSarahMovementIntent Intent;
+        if (InputSource->GatherMovementIntent(this, Intent))
+        {
+            ApplyMovementIntent(Intent);
+        }
+    }
+
+    // Keep our cell in the avoidance grid current, moving or not
+    if (AvoidanceAgentHandle != INDEX_NONE)
+    {
+        if (USarahAvoidanceSubsystem* Avoidance = GetWorld()->GetSubsystem<USarahAvoidanceSubsystem>())
+        {
+            Avoidance->UpdateAgent(AvoidanceAgentHandle, GetActorLocation());
+        }
+    }
+
+#if !UE_BUILD_SHIPPING
+    const uint64 UpdateStartCycles = FPlatformTime::Cycles64();
+#endif
+
     // Update all systems
     UpdateCameraRotationReference();
-    UpdateMovement(DeltaTime);
-    UpdateStateMachine(DeltaTime);
+
+    if (bUseFixedSimulationStep)
+    {
+        TickFixedSimulation(DeltaTime);
+        ApplyMovementInput();
+    }
+    else
+    {
+        UpdateMovement(DeltaTime);
+        ApplyMovementInput();
+        UpdateStateMachine(DeltaTime);
+    }
+
+#if !UE_BUILD_SHIPPING
+    MovementUpdateCycles += FPlatformTime::Cycles64() - UpdateStartCycles;
+#endif
+
+    if (bRegisteredWithAnimationBudget)
+    {
+        INC_DWORD_STAT(STAT_SarahBudgetedMeshes);
+#if STATS
+        // Global value: the first budgeted Sarah of the frame sets it
+        static uint64 BudgetStatFrame = 0;
+        static IConsoleVariable* BudgetMsVar = IConsoleManager::Get().FindConsoleVariable(TEXT("a.Budget.BudgetMs"));
+        if (BudgetMsVar && BudgetStatFrame != GFrameCounter)
+        {
+            BudgetStatFrame = GFrameCounter;
+            SET_FLOAT_STAT(STAT_SarahAnimBudgetMs, BudgetMsVar->GetFloat());
+        }
+#endif
+    }
+
+    // Record this frame for rollback
+    if (SnapshotHistory.Num() > 0)
+    {
+        SaveMovementSnapshot(SnapshotHistory[SnapshotHistoryHead]);
+        SnapshotHistoryHead = (SnapshotHistoryHead + 1) % SnapshotHistory.Num();
+        SnapshotHistoryCount = FMath::Min(SnapshotHistoryCount + 1, SnapshotHistory.Num());
+    }
+}
+
+void ASarahCharacter::TickFixedSimulation(float DeltaTime)
+{
+    const float StepSeconds = 1.0f / FMath::Max(SimulationStepRate, 1.0f);
+    SimulationAccumulator += DeltaTime;
+
+    int32 StepsThisFrame = 0;
+    while (SimulationAccumulator >= StepSeconds && StepsThisFrame < MaxSimulationStepsPerFrame)
+    {
+        // Resync with the actor if something else rotated it since our last step
+        if (!bHasSimulatedRotation)
+        {
+            SimulatedYaw = GetActorRotation().Yaw;
+        }
+        bHasSimulatedRotation = false;
+        PreviousSimulatedYaw = SimulatedYaw;
+
+        UpdateMovement(StepSeconds);
+        UpdateStateMachine(StepSeconds);
+
+        SimulationAccumulator -= StepSeconds;
+        ++StepsThisFrame;
+    }
+
+    // Drop time we could not catch up on instead of spiralling
+    if (StepsThisFrame >= MaxSimulationStepsPerFrame)
+    {
+        SimulationAccumulator = FMath::Min(SimulationAccumulator, StepSeconds);
+    }
+
+    // Present rotation interpolated between the last two steps
+    if (bHasSimulatedRotation)
+    {
+        const float Alpha = FMath::Clamp(SimulationAccumulator / StepSeconds, 0.0f, 1.0f);
+        const float VisibleYaw = PreviousSimulatedYaw + FindShortestAnglePath(PreviousSimulatedYaw, SimulatedYaw) * Alpha;
+        ApplyFacingYaw(VisibleYaw);
+    }
 }
 
 void ASarahCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -267,12 +552,31 @@ void ASarahCharacter::HandleLook(const FInputActionValue& Value)
 
 void ASarahCharacter::HandleStartSprint()
 {
+    if (bIsSprinting) return;
+
     bIsSprinting = true;
+    BroadcastSprintChanged();
 }
 
 void ASarahCharacter::HandleStopSprint()
 {
+    if (!bIsSprinting) return;
+
     bIsSprinting = false;
+    BroadcastSprintChanged();
+}
+
+void ASarahCharacter::BroadcastSprintChanged()
+{
+    OnSarahSprintChanged.Broadcast(this, bIsSprinting);
+
+    if (bBatchStateEvents)
+    {
+        if (USarahStateEventSubsystem* Events = GetWorld()->GetSubsystem<USarahStateEventSubsystem>())
+        {
+            Events->QueueSprintChange(this, bIsSprinting);
+        }
+    }
 }
 
 void ASarahCharacter::HandleJump()
@@ -284,10 +588,94 @@ void ASarahCharacter::HandleJump()
     }
 }
 
+void ASarahCharacter::SetSarahMoveInput(FVector2D Input)
+{
+    if (Input.IsNearlyZero())
+    {
+        HandleMoveStop(FInputActionValue(FVector2D::ZeroVector));
+    }
+    else
+    {
+        HandleMove(FInputActionValue(Input));
+    }
+}
+
+void ASarahCharacter::SetSarahIsSprinting(bool bSprint)
+{
+    if (bSprint)
+    {
+        HandleStartSprint();
+    }
+    else
+    {
+        HandleStopSprint();
+    }
+}
+
+void ASarahCharacter::SarahJump()
+{
+    HandleJump();
+}
+
+void ASarahCharacter::SetSarahInputSource(TScriptInterface<ISarahInputSource> NewInputSource)
+{
+    InputSource = NewInputSource;
+}
+
+void ASarahCharacter::ApplyMovementIntent(const FSarahMovementIntent& Intent)
+{
+    if (Intent.MoveInput != MoveInput)
+    {
+        SetSarahMoveInput(Intent.MoveInput);
+    }
+
+    if (Intent.bSprint != bIsSprinting)
+    {
+        SetSarahIsSprinting(Intent.bSprint);
+    }
+
+    if (Intent.bJump)
+    {
+        SarahJump();
+    }
+}
+
+FVector2D ASarahCharacter::MakeMoveInputFromWorldDirection(FVector WorldDirection) const
+{
+    const float Magnitude = FMath::Min(WorldDirection.Size2D(), 1.0f);
+    if (Magnitude < KINDA_SMALL_NUMBER)
+    {
+        return FVector2D::ZeroVector;
+    }
+
+    // Same reference yaw CalculateContinuousInputAngle will use
+    const float ReferenceYaw = bUsingCameraRelativeMovement ? LockedCameraYaw : CurrentCameraYaw;
+    const float WorldAngle = FMath::RadiansToDegrees(FMath::Atan2(WorldDirection.Y, WorldDirection.X));
+    const float InputAngleRad = FMath::DegreesToRadians(WorldAngle - ReferenceYaw + 90.0f);
+
+    // Undo the X inversion applied to raw input
+    return FVector2D(-FMath::Cos(InputAngleRad), FMath::Sin(InputAngleRad)) * Magnitude;
+}
+
 void ASarahCharacter::ChangeState(ESarahMovementState NewState)
 {
     if (CurrentState == NewState) return;
 
+    // Enter logic may chain into another ChangeState; this call reports only its own edge
+    const ESarahMovementState FromState = CurrentState;
+
+    if (FSarahStateTelemetry::IsEnabled())
+    {
+        FSarahStateTelemetryRecord Record;
+        Record.Timestamp = GetWorld()->GetTimeSeconds();
+        Record.CharacterId = GetUniqueID();
+        Record.FromState = CurrentState;
+        Record.ToState = NewState;
+        Record.Speed = GetVelocity().Size2D();
+        Record.MovementAngle = CurrentMovementAngle;
+        FSarahStateTelemetry::Record(Record);
+    }
+
     // Execute exit logic for current state
     switch (CurrentState)
     {
@@ -298,9 +686,20 @@ void ASarahCharacter::ChangeState(ESarahMovementState NewState)
     case ESarahMovementState::Landing: ExitLanding(); break;
     }
 
-    PreviousState = CurrentState;
+    PreviousState = FromState;
     CurrentState = NewState;
 
+    // Notify before Enter so a chained transition is reported after this one
+    OnSarahMovementStateChanged.Broadcast(this, FromState, NewState);
+
+    if (bBatchStateEvents)
+    {
+        if (USarahStateEventSubsystem* Events = GetWorld()->GetSubsystem<USarahStateEventSubsystem>())
+        {
+            Events->QueueStateChange(this, FromState, NewState);
+        }
+    }
+
     // Execute enter logic for new state
     switch (NewState)
     {
@@ -310,10 +709,14 @@ void ASarahCharacter::ChangeState(ESarahMovementState NewState)
     case ESarahMovementState::Jump: EnterJump(); break;
     case ESarahMovementState::Landing: EnterLanding(); break;
     }
+
+    UpdateAnimationBudgetSignificance();
 }
 
 void ASarahCharacter::UpdateStateMachine(float DeltaTime)
 {
+    SCOPE_CYCLE_COUNTER(STAT_SarahUpdateStateMachine);
+
     // Delegate to current state's update function
     switch (CurrentState)
     {
@@ -339,6 +742,13 @@ void ASarahCharacter::EnterIdle()
 {
     SetMovementSpeed(0.0f);
 
+    // Matched stop when coming out of locomotion
+    const bool bWasMoving = PreviousState == ESarahMovementState::Walk || PreviousState == ESarahMovementState::Run;
+    if (bWasMoving && PlayMatchedPose(0.0f))
+    {
+        return;
+    }
+
     if (IdleAnimation)
     {
         PlayAnimationInternal(IdleAnimation);
@@ -347,16 +757,14 @@ void ASarahCharacter::EnterIdle()
 
 void ASarahCharacter::UpdateIdle(float DeltaTime)
 {
-    if (HasMovementInput())
+    const ESarahMovementState NextState = GetLocomotionTransition(CurrentState, HasMovementInput(), bIsSprinting);
+    if (NextState != CurrentState)
     {
-        if (bIsSprinting)
-        {
-            ChangeState(ESarahMovementState::Run);
-        }
-        else
-        {
-            ChangeState(ESarahMovementState::Walk);
-        }
+        ChangeState(NextState);
+    }
+    else
+    {
+        UpdateMatchedTransition();
     }
 }
 
@@ -368,18 +776,24 @@ void ASarahCharacter::ExitIdle()
 void ASarahCharacter::EnterWalk()
 {
     SetMovementSpeed(WalkSpeed);
-    PlayAnimationInternal(WalkAnimation);
+
+    if (!PlayMatchedPose(WalkSpeed))
+    {
+        PlayAnimationInternal(WalkAnimation);
+    }
 }
 
 void ASarahCharacter::UpdateWalk(float DeltaTime)
 {
-    if (!HasMovementInput())
+    const ESarahMovementState NextState = GetLocomotionTransition(CurrentState, HasMovementInput(), bIsSprinting);
+    if (NextState != CurrentState)
     {
-        ChangeState(ESarahMovementState::Idle);
+        ChangeState(NextState);
     }
-    else if (bIsSprinting)
+    else
     {
-        ChangeState(ESarahMovementState::Run);
+        UpdatePoseMatchedPivot(WalkSpeed);
+        UpdateMatchedTransition();
     }
 }
 
@@ -391,18 +805,24 @@ void ASarahCharacter::ExitWalk()
 void ASarahCharacter::EnterRun()
 {
     SetMovementSpeed(RunSpeed);
-    PlayAnimationInternal(RunAnimation);
+
+    if (!PlayMatchedPose(RunSpeed))
+    {
+        PlayAnimationInternal(RunAnimation);
+    }
 }
 
 void ASarahCharacter::UpdateRun(float DeltaTime)
 {
-    if (!HasMovementInput())
+    const ESarahMovementState NextState = GetLocomotionTransition(CurrentState, HasMovementInput(), bIsSprinting);
+    if (NextState != CurrentState)
     {
-        ChangeState(ESarahMovementState::Idle);
+        ChangeState(NextState);
     }
-    else if (!bIsSprinting)
+    else
     {
-        ChangeState(ESarahMovementState::Walk);
+        UpdatePoseMatchedPivot(RunSpeed);
+        UpdateMatchedTransition();
     }
 }
 
@@ -496,13 +916,13 @@ void ASarahCharacter::EnterLanding()
     SetMovementSpeed(0.0f);
 
     // Stop any current animation immediately
-    if (GetMesh())
+    if (GetMesh() && !bIsLeanServer)
     {
         GetMesh()->Stop();
     }
 
-    // Play the landing animation
-    if (LandingAnimation)
+    // Play the landing animation; lean servers hold the same lockout without it
+    if (LandingAnimationLength > 0.0f)
     {
         PlayAnimationInternal(LandingAnimation);
     }
@@ -516,7 +936,7 @@ void ASarahCharacter::EnterLanding()
 void ASarahCharacter::UpdateLanding(float DeltaTime)
 {
     // Check if landing animation has completed
-    if (LandingAnimation && !bLandingAnimationCompleted && bLandingStateActive)
+    if (LandingAnimationLength > 0.0f && !bLandingAnimationCompleted && bLandingStateActive)
     {
         float CurrentTime = GetWorld()->GetTimeSeconds();
         float TimeSinceLandingStart = CurrentTime - LandingStartTime;
@@ -531,7 +951,7 @@ void ASarahCharacter::UpdateLanding(float DeltaTime)
             bLandingStateActive = false;
 
             // Stop the landing animation and immediately go to idle
-            if (GetMesh())
+            if (GetMesh() && !bIsLeanServer)
             {
                 GetMesh()->Stop();
             }
@@ -551,6 +971,8 @@ void ASarahCharacter::ExitLanding()
 
 void ASarahCharacter::UpdateMovement(float DeltaTime)
 {
+    SCOPE_CYCLE_COUNTER(STAT_SarahUpdateMovement);
+
     // Don't process normal movement during jump or landing states
     if (CurrentState == ESarahMovementState::Jump || CurrentState == ESarahMovementState::Landing)
     {
@@ -568,11 +990,63 @@ void ASarahCharacter::UpdateMovement(float DeltaTime)
         // Update continuous angle interpolation
         UpdateContinuousMovementAngle(DeltaTime);
 
+        // Steer around nearby Sarahs
+        UpdateLocalAvoidance(DeltaTime);
+
+        // Update character facing direction
+        UpdateCharacterRotation(DeltaTime);
+    }
+    else
+    {
+        // Stop camera-relative system when no input
+        StopCameraRelativeMovement();
+        AvoidanceYawOffset = 0.0f;
+    }
+}
+
+void ASarahCharacter::UpdateLocalAvoidance(float DeltaTime)
+{
+    float DesiredOffset = 0.0f;
+
+    if (bUseLocalAvoidance && bUsingCameraRelativeMovement && AvoidanceAgentHandle != INDEX_NONE)
+    {
+        if (USarahAvoidanceSubsystem* Avoidance = GetWorld()->GetSubsystem<USarahAvoidanceSubsystem>())
+        {
+            const FVector2D Separation = Avoidance->ComputeSeparation(AvoidanceAgentHandle, AvoidanceRadius);
+            if (!Separation.IsNearlyZero())
+            {
+                // Blend the unsteered heading with the push away from neighbors
+                const float MovementAngleRad = FMath::DegreesToRadians(CurrentMovementAngle);
+                const FVector2D Steered = FVector2D(FMath::Cos(MovementAngleRad), FMath::Sin(MovementAngleRad)) + Separation * AvoidanceWeight;
+                if (!Steered.IsNearlyZero())
+                {
+                    const float SteeredAngle = FMath::RadiansToDegrees(FMath::Atan2(Steered.Y, Steered.X));
+                    DesiredOffset = FMath::Clamp(FindShortestAnglePath(CurrentMovementAngle, SteeredAngle), -MaxAvoidanceAngle, MaxAvoidanceAngle);
+                }
+            }
+        }
+    }
+
+    // Kept as an offset on top of CurrentMovementAngle so the continuous
+    // angle interpolation does not fight the steering
+    AvoidanceYawOffset = FMath::FInterpTo(AvoidanceYawOffset, DesiredOffset, DeltaTime, ContinuousRotationSpeed);
+}
+
+void ASarahCharacter::ApplyMovementInput()
+{
+    // The CMC consumes pending input every frame, so this runs outside the fixed step
+    if (CurrentState == ESarahMovementState::Jump || CurrentState == ESarahMovementState::Landing)
+    {
+        return;
+    }
+
+    if (HasMovementInput())
+    {
         FVector MovementDirection;
         if (bUsingCameraRelativeMovement)
         {
             // Use interpolated angle for smooth directional changes
-            float MovementAngleRad = FMath::DegreesToRadians(CurrentMovementAngle);
+            float MovementAngleRad = FMath::DegreesToRadians(CurrentMovementAngle + AvoidanceYawOffset);
             MovementDirection = FVector(
                 FMath::Cos(MovementAngleRad),
                 FMath::Sin(MovementAngleRad),
@@ -589,23 +1063,20 @@ void ASarahCharacter::UpdateMovement(float DeltaTime)
         float InputMagnitude = MoveInput.Size();
         float MovementIntensity = FMath::Clamp(InputMagnitude, 0.1f, 1.0f);
         AddMovementInput(MovementDirection, MovementIntensity);
-
-        // Update character facing direction
-        UpdateCharacterRotation();
-    }
-    else
-    {
-        // Stop camera-relative system when no input
-        StopCameraRelativeMovement();
     }
 }
 
 void ASarahCharacter::UpdateCameraRotationReference()
 {
-    if (FollowCamera)
+    if (FollowCamera && !bIsLeanServer)
     {
         CurrentCameraYaw = FollowCamera->GetComponentRotation().Yaw;
     }
+    else if (Controller)
+    {
+        // No camera on lean servers, use the replicated control rotation
+        CurrentCameraYaw = GetControlRotation().Yaw;
+    }
 }
 
 FVector ASarahCharacter::CalculateCameraRelativeDirection(float CameraYaw, FVector2D Input) const
@@ -638,7 +1109,8 @@ bool ASarahCharacter::StartCameraRelativeMovement()
     // Only start camera-relative movement from idle state
     if (CurrentState == ESarahMovementState::Idle && !bUsingCameraRelativeMovement)
     {
-        if (!FollowCamera) return false;
+        // Lean servers take the reference from the controller, as UpdateCameraRotationReference does
+        if ((!FollowCamera || bIsLeanServer) && !Controller) return false;
 
         LockedCameraYaw = CurrentCameraYaw;
         bUsingCameraRelativeMovement = true;
@@ -663,15 +1135,20 @@ float ASarahCharacter::CalculateContinuousInputAngle() const
 {
     if (!HasMovementInput()) return CurrentMovementAngle;
 
+    return InputToWorldAngle(MoveInput, LockedCameraYaw);
+}
+
+float ASarahCharacter::InputToWorldAngle(FVector2D Input, float ReferenceYaw)
+{
     // Convert input to screen-space angle
-    FVector2D InvertedInput = FVector2D(-MoveInput.X, MoveInput.Y);
+    FVector2D InvertedInput = FVector2D(-Input.X, Input.Y);
     float InputAngle = FMath::RadiansToDegrees(FMath::Atan2(InvertedInput.Y, InvertedInput.X));
 
     // Normalize to [0, 360) range
     if (InputAngle < 0) InputAngle += 360.0f;
 
     // Convert to world space angle
-    float WorldAngle = InputAngle + LockedCameraYaw - 90.0f;
+    float WorldAngle = InputAngle + ReferenceYaw - 90.0f;
 
     // Normalize world angle
     while (WorldAngle >= 360.0f) WorldAngle -= 360.0f;
@@ -680,7 +1157,7 @@ float ASarahCharacter::CalculateContinuousInputAngle() const
     return WorldAngle;
 }
 
-float ASarahCharacter::FindShortestAnglePath(float CurrentAngle, float TargetAngle) const
+float ASarahCharacter::FindShortestAnglePath(float CurrentAngle, float TargetAngle)
 {
     float Difference = TargetAngle - CurrentAngle;
 
@@ -700,37 +1177,39 @@ void ASarahCharacter::UpdateContinuousMovementAngle(float DeltaTime)
 
     // Calculate desired movement angle from input
     TargetMovementAngle = CalculateContinuousInputAngle();
-    float AngleDifference = FindShortestAnglePath(CurrentMovementAngle, TargetMovementAngle);
+    bIsTransitioningAngle = StepContinuousAngle(CurrentMovementAngle, TargetMovementAngle, ContinuousRotationSpeed, DeltaTime);
+}
+
+bool ASarahCharacter::StepContinuousAngle(float& InOutAngle, float TargetAngle, float RotationSpeed, float DeltaTime)
+{
+    float AngleDifference = FindShortestAnglePath(InOutAngle, TargetAngle);
 
     // Only interpolate if angle change is significant
     if (FMath::Abs(AngleDifference) > 0.4f)
     {
-        bIsTransitioningAngle = true;
-
         // Dynamic rotation speed based on angle difference
-        float TransitionSpeed = ContinuousRotationSpeed * (FMath::Abs(AngleDifference) / 180.0f) * 1.05f;
+        float TransitionSpeed = RotationSpeed * (FMath::Abs(AngleDifference) / 180.0f) * 1.05f;
 
         // Apply rotation
         float AngleStep = AngleDifference * TransitionSpeed * DeltaTime;
-        CurrentMovementAngle += AngleStep;
+        InOutAngle += AngleStep;
 
         // Keep angle in valid range
-        while (CurrentMovementAngle >= 360.0f) CurrentMovementAngle -= 360.0f;
-        while (CurrentMovementAngle < 0.0f) CurrentMovementAngle += 360.0f;
+        while (InOutAngle >= 360.0f) InOutAngle -= 360.0f;
+        while (InOutAngle < 0.0f) InOutAngle += 360.0f;
 
         // Snap to target when close enough
-        if (FMath::Abs(FindShortestAnglePath(CurrentMovementAngle, TargetMovementAngle)) < 1.5f)
+        if (FMath::Abs(FindShortestAnglePath(InOutAngle, TargetAngle)) < 1.5f)
         {
-            CurrentMovementAngle = TargetMovementAngle;
-            bIsTransitioningAngle = false;
+            InOutAngle = TargetAngle;
+            return false;
         }
+        return true;
     }
-    else
-    {
-        // No significant change needed
-        bIsTransitioningAngle = false;
-        CurrentMovementAngle = TargetMovementAngle;
-    }
+
+    // No significant change needed
+    InOutAngle = TargetAngle;
+    return false;
 }
 
 FVector ASarahCharacter::GetMovementDirection() const
@@ -741,7 +1220,7 @@ FVector ASarahCharacter::GetMovementDirection() const
     if (bUsingCameraRelativeMovement)
     {
         // Direction from interpolated angle
-        float MovementAngleRad = FMath::DegreesToRadians(CurrentMovementAngle);
+        float MovementAngleRad = FMath::DegreesToRadians(CurrentMovementAngle + AvoidanceYawOffset);
         return FVector(
             FMath::Cos(MovementAngleRad),
             FMath::Sin(MovementAngleRad),
@@ -755,18 +1234,33 @@ FVector ASarahCharacter::GetMovementDirection() const
     }
 }
 
-void ASarahCharacter::UpdateCharacterRotation()
+void ASarahCharacter::UpdateCharacterRotation(float DeltaTime)
 {
     FVector MovementDirection = GetMovementDirection();
     if (!MovementDirection.IsNearlyZero())
     {
-        // Smoothly interpolate to face movement direction
         FRotator TargetRotation = MovementDirection.Rotation();
-        FRotator CurrentRotation = GetActorRotation();
+
+        // In fixed-step mode the simulated yaw is presented by TickFixedSimulation
+        if (bUseFixedSimulationStep)
+        {
+            SimulatedYaw = FMath::RInterpTo(FRotator(0, SimulatedYaw, 0), TargetRotation, DeltaTime, RotationInterpSpeed).Yaw;
+            bHasSimulatedRotation = true;
+            return;
+        }
+
+        // The movement component interpolates and sleeps once facing matches
+        if (USarahMovementComponent* SarahMovement = GetSarahMovement())
+        {
+            SarahMovement->SetDesiredFacingYaw(TargetRotation.Yaw, RotationInterpSpeed);
+            return;
+        }
+
+        // Smoothly interpolate to face movement direction
         FRotator NewRotation = FMath::RInterpTo(
-            CurrentRotation,
+            GetActorRotation(),
             TargetRotation,
-            GetWorld()->GetDeltaSeconds(),
+            DeltaTime,
             RotationInterpSpeed
         );
 
@@ -775,19 +1269,64 @@ void ASarahCharacter::UpdateCharacterRotation()
     }
 }
 
+void ASarahCharacter::ApplyFacingYaw(float Yaw)
+{
+    if (USarahMovementComponent* SarahMovement = GetSarahMovement())
+    {
+        SarahMovement->SetDesiredFacingYaw(Yaw, 0.0f);
+    }
+    else
+    {
+        SetActorRotation(FRotator(0, Yaw, 0));
+    }
+}
+
+USarahMovementComponent* ASarahCharacter::GetSarahMovement() const
+{
+    return Cast<USarahMovementComponent>(GetCharacterMovement());
+}
+
 bool ASarahCharacter::HasMovementInput() const
 {
-    return (FMath::Abs(MoveInput.X) > 0.01f || FMath::Abs(MoveInput.Y) > 0.01f);
+    return IsMoveInputActive(MoveInput);
+}
+
+bool ASarahCharacter::IsMoveInputActive(FVector2D Input)
+{
+    return (FMath::Abs(Input.X) > 0.01f || FMath::Abs(Input.Y) > 0.01f);
+}
+
+ESarahMovementState ASarahCharacter::GetLocomotionTransition(ESarahMovementState State, bool bHasInput, bool bSprinting)
+{
+    // Only the ground locomotion states follow input; Jump and Landing drive themselves
+    switch (State)
+    {
+    case ESarahMovementState::Idle:
+    case ESarahMovementState::Walk:
+    case ESarahMovementState::Run:
+        if (!bHasInput)
+        {
+            return ESarahMovementState::Idle;
+        }
+        return bSprinting ? ESarahMovementState::Run : ESarahMovementState::Walk;
+    default:
+        return State;
+    }
 }
 
-bool ASarahCharacter::PlayAnimationInternal(UAnimSequence* Animation)
+bool ASarahCharacter::PlayAnimationInternal(UAnimSequence* Animation, bool bLooping)
 {
-    if (!Animation || !GetMesh()) return false;
+    if (!Animation || !GetMesh() || bIsLeanServer) return false;
+
+    bPlayingMatchedTransition = false;
+
+    if (bLooping && bUseSharedAnimation && TryPlaySharedAnimation(Animation)) return true;
+    LeaveSharedAnimation();
 
     // Stop current animation before playing new one
     if (CurrentAnimation) GetMesh()->Stop();
 
-    GetMesh()->PlayAnimation(Animation, true);
+    GetMesh()->PlayAnimation(Animation, bLooping);
     CurrentAnimation = Animation;
     GetMesh()->SetPlayRate(1.0f);
     return true;
@@ -795,7 +1334,11 @@ bool ASarahCharacter::PlayAnimationInternal(UAnimSequence* Animation)
 
 bool ASarahCharacter::PlayAnimationWithSpeed(UAnimSequence* Animation, float Speed)
 {
-    if (!Animation || !GetMesh()) return false;
+    if (!Animation || !GetMesh() || bIsLeanServer) return false;
+
+    // Play rate is per character, so never shared
+    bPlayingMatchedTransition = false;
+    LeaveSharedAnimation();
 
     if (CurrentAnimation) GetMesh()->Stop();
 
@@ -828,8 +1371,124 @@ void ASarahCharacter::StopAnimationDirect()
 {
     if (GetMesh())
     {
+        LeaveSharedAnimation();
         GetMesh()->Stop();
         CurrentAnimation = nullptr;
+        bPlayingMatchedTransition = false;
+    }
+}
+
+bool ASarahCharacter::TryPlaySharedAnimation(UAnimSequence* Animation)
+{
+    // Only the looping locomotion states are shared; transitions stay per character
+    UAnimSequence* StateAnimation = GetStateLoopAnimation();
+    if (!StateAnimation || StateAnimation != Animation) return false;
+
+    USarahAnimationSharingSubsystem* Sharing = GetWorld()->GetSubsystem<USarahAnimationSharingSubsystem>();
+    if (!Sharing) return false;
+
+    // Stable per-character time offset
+    const int32 NumBuckets = FMath::Max(SharedAnimationPhaseBuckets, 1);
+    const int32 PhaseBucket = static_cast<int32>(GetUniqueID() % static_cast<uint32>(NumBuckets));
+
+    USkeletalMeshComponent* Leader = Sharing->AcquireLeader(CurrentState, Animation, GetMesh()->GetSkeletalMeshAsset(), PhaseBucket, NumBuckets);
+    if (!Leader) return false;
+
+    if (CurrentAnimation) GetMesh()->Stop();
+    GetMesh()->SetLeaderPoseComponent(Leader);
+    CurrentAnimation = Animation;
+    return true;
+}
+
+UAnimSequence* ASarahCharacter::GetStateLoopAnimation() const
+{
+    switch (CurrentState)
+    {
+    case ESarahMovementState::Idle: return IdleAnimation;
+    case ESarahMovementState::Walk: return WalkAnimation;
+    case ESarahMovementState::Run: return RunAnimation;
+    default: return nullptr;
+    }
+}
+
+bool ASarahCharacter::PlayMatchedPose(float DesiredSpeed)
+{
+    if (!PoseDatabase || !GetMesh() || bIsLeanServer) return false;
+
+    FSarahPoseQuery Query;
+    Query.RootSpeed = DesiredSpeed;
+
+    // Approximate turn rate RInterpTo will produce towards the target direction
+    Query.FacingDelta = FindShortestAnglePath(GetActorRotation().Yaw, TargetMovementAngle) * RotationInterpSpeed;
+
+    const FVector LeftFoot = GetMesh()->GetBoneLocation(PoseDatabase->LeftFootBone, EBoneSpaces::ComponentSpace);
+    const FVector RightFoot = GetMesh()->GetBoneLocation(PoseDatabase->RightFootBone, EBoneSpaces::ComponentSpace);
+    Query.LeftFoot = FVector2D(LeftFoot.X, LeftFoot.Y);
+    Query.RightFoot = FVector2D(RightFoot.X, RightFoot.Y);
+
+    UAnimSequence* Sequence = nullptr;
+    float Time = 0.0f;
+    if (!PoseDatabase->FindBestPose(Query, Sequence, Time)) return false;
+
+    LastPoseMatchAngle = TargetMovementAngle;
+
+    // Anything but the state's own loop is a start/stop clip and plays once
+    const bool bTransitionClip = Sequence != GetStateLoopAnimation();
+
+    // Already on the state's loop, or mid start/stop clip: keep playing instead of restarting.
+    // The previous state's loop is still current on entry and must be replayed once.
+    if (Sequence == CurrentAnimation && (!bTransitionClip || bPlayingMatchedTransition)) return true;
+
+    if (!PlayAnimationInternal(Sequence, !bTransitionClip)) return false;
+    GetMesh()->SetPosition(Time, false);
+    bPlayingMatchedTransition = bTransitionClip;
+    return true;
+}
+
+void ASarahCharacter::UpdatePoseMatchedPivot(float DesiredSpeed)
+{
+    if (!PoseDatabase) return;
+
+    if (FMath::Abs(FindShortestAnglePath(LastPoseMatchAngle, TargetMovementAngle)) > PoseMatchAngleThreshold)
+    {
+        PlayMatchedPose(DesiredSpeed);
+    }
+}
+
+void ASarahCharacter::UpdateMatchedTransition()
+{
+    if (!bPlayingMatchedTransition || !CurrentAnimation || !GetMesh()) return;
+
+    const bool bFinished = !GetMesh()->IsPlaying() || GetMesh()->GetPosition() >= CurrentAnimation->GetPlayLength();
+    if (!bFinished) return;
+
+    // Hand back to the state's loop, or hold the last frame if there is none
+    if (!PlayAnimationInternal(GetStateLoopAnimation()))
+    {
+        bPlayingMatchedTransition = false;
+    }
+}
+
+void ASarahCharacter::UpdateAnimationBudgetSignificance()
+{
+    if (!bRegisteredWithAnimationBudget) return;
+
+    USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+    IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+    if (!BudgetedMesh || !Allocator) return;
+
+    const float* Significance = AnimationStateSignificance.Find(CurrentState);
+
+    // Off-screen meshes may skip entirely; interpolation covers skipped frames on screen
+    Allocator->SetComponentSignificance(BudgetedMesh, Significance ? *Significance : 0.5f,
+        /*bNeverSkip*/ false, /*bTickEvenIfNotRendered*/ false, /*bAllowReducedWork*/ true, /*bForceInterpolate*/ false);
+}
+
+void ASarahCharacter::LeaveSharedAnimation()
+{
+    if (GetMesh() && GetMesh()->LeaderPoseComponent.IsValid())
+    {
+        GetMesh()->SetLeaderPoseComponent(nullptr);
     }
 }
 
@@ -838,3 +1497,154 @@ FString ASarahCharacter::GetMovementDirectionName() const
     if (!HasMovementInput()) return TEXT("None");
     return FString::Printf(TEXT("%.1f°"), CurrentMovementAngle);
 }
+
+bool ASarahCharacter::GetMovementDirectionAngle(float& OutAngle) const
+{
+    OutAngle = CurrentMovementAngle;
+    return HasMovementInput();
+}
+
+int32 ASarahCharacter::WriteDebugSummary(TCHAR* Buffer, int32 BufferSize) const
+{
+    static const TCHAR* StateNames[] = { TEXT("Idle"), TEXT("Walk"), TEXT("Run"), TEXT("Jump"), TEXT("Landing") };
+
+    const TCHAR* JumpPhase = TEXT("-");
+    if (CurrentState == ESarahMovementState::Jump)
+    {
+        JumpPhase = bJumpStartCompleted ? TEXT("Fall") : TEXT("Start");
+    }
+    else if (CurrentState == ESarahMovementState::Landing)
+    {
+        JumpPhase = TEXT("Land");
+    }
+
+    const int32 Written = FCString::Snprintf(Buffer, BufferSize, TEXT("%s  %.1f°  %.0f cm/s  %s  %s"),
+        StateNames[static_cast<uint8>(CurrentState)],
+        CurrentMovementAngle,
+        GetVelocity().Size2D(),
+        bIsSprinting ? TEXT("Sprint") : TEXT("-"),
+        JumpPhase);
+
+    return FMath::Clamp(Written, 0, BufferSize - 1);
+}
+
+void ASarahCharacter::SaveMovementSnapshot(FSarahMovementSnapshot& OutSnapshot) const
+{
+    OutSnapshot.CurrentState = CurrentState;
+    OutSnapshot.PreviousState = PreviousState;
+
+    OutSnapshot.MoveInput = MoveInput;
+    OutSnapshot.bIsSprinting = bIsSprinting;
+
+    OutSnapshot.CurrentCameraYaw = CurrentCameraYaw;
+    OutSnapshot.LockedCameraYaw = LockedCameraYaw;
+    OutSnapshot.bUsingCameraRelativeMovement = bUsingCameraRelativeMovement;
+    OutSnapshot.CurrentMovementAngle = CurrentMovementAngle;
+    OutSnapshot.TargetMovementAngle = TargetMovementAngle;
+    OutSnapshot.bIsTransitioningAngle = bIsTransitioningAngle;
+    OutSnapshot.AvoidanceYawOffset = AvoidanceYawOffset;
+
+    OutSnapshot.SimulationAccumulator = SimulationAccumulator;
+    OutSnapshot.SimulatedYaw = SimulatedYaw;
+    OutSnapshot.PreviousSimulatedYaw = PreviousSimulatedYaw;
+    OutSnapshot.bHasSimulatedRotation = bHasSimulatedRotation;
+
+    OutSnapshot.bJumpStartCompleted = bJumpStartCompleted;
+    OutSnapshot.bIsFalling = bIsFalling;
+    OutSnapshot.JumpStartTime = JumpStartTime;
+    OutSnapshot.PreviousZVelocity = PreviousZVelocity;
+    OutSnapshot.LandingStartTime = LandingStartTime;
+    OutSnapshot.bLandingAnimationCompleted = bLandingAnimationCompleted;
+    OutSnapshot.bLandingStateActive = bLandingStateActive;
+
+    OutSnapshot.MaxWalkSpeed = GetCharacterMovement() ? GetCharacterMovement()->MaxWalkSpeed : 0.0f;
+
+    OutSnapshot.CurrentAnimation = CurrentAnimation;
+    OutSnapshot.AnimationPosition = (CurrentAnimation && GetMesh()) ? GetMesh()->GetPosition() : 0.0f;
+
+    OutSnapshot.bPlayingMatchedTransition = bPlayingMatchedTransition;
+    OutSnapshot.LastPoseMatchAngle = LastPoseMatchAngle;
+}
+
+void ASarahCharacter::RestoreMovementSnapshot(const FSarahMovementSnapshot& Snapshot)
+{
+    // Restore raw state without running Enter/Exit logic
+    CurrentState = Snapshot.CurrentState;
+    PreviousState = Snapshot.PreviousState;
+
+    MoveInput = Snapshot.MoveInput;
+    bIsSprinting = Snapshot.bIsSprinting;
+
+    CurrentCameraYaw = Snapshot.CurrentCameraYaw;
+    LockedCameraYaw = Snapshot.LockedCameraYaw;
+    bUsingCameraRelativeMovement = Snapshot.bUsingCameraRelativeMovement;
+    CurrentMovementAngle = Snapshot.CurrentMovementAngle;
+    TargetMovementAngle = Snapshot.TargetMovementAngle;
+    bIsTransitioningAngle = Snapshot.bIsTransitioningAngle;
+    AvoidanceYawOffset = Snapshot.AvoidanceYawOffset;
+
+    SimulationAccumulator = Snapshot.SimulationAccumulator;
+    SimulatedYaw = Snapshot.SimulatedYaw;
+    PreviousSimulatedYaw = Snapshot.PreviousSimulatedYaw;
+    bHasSimulatedRotation = Snapshot.bHasSimulatedRotation;
+
+    bJumpStartCompleted = Snapshot.bJumpStartCompleted;
+    bIsFalling = Snapshot.bIsFalling;
+    JumpStartTime = Snapshot.JumpStartTime;
+    PreviousZVelocity = Snapshot.PreviousZVelocity;
+    LandingStartTime = Snapshot.LandingStartTime;
+    bLandingAnimationCompleted = Snapshot.bLandingAnimationCompleted;
+    bLandingStateActive = Snapshot.bLandingStateActive;
+
+    SetMovementSpeed(Snapshot.MaxWalkSpeed);
+
+    LastPoseMatchAngle = Snapshot.LastPoseMatchAngle;
+
+    // Only restart the sequence if it or its looping mode differs, then seek.
+    // A sequence unloaded since the snapshot was taken restores as no animation.
+    UAnimSequence* SnapshotAnimation = Snapshot.CurrentAnimation.Get();
+    if (SnapshotAnimation != CurrentAnimation || Snapshot.bPlayingMatchedTransition != bPlayingMatchedTransition)
+    {
+        if (SnapshotAnimation)
+        {
+            // Matched start/stop clips were started as one-shots
+            bPlayingMatchedTransition = PlayAnimationInternal(SnapshotAnimation, !Snapshot.bPlayingMatchedTransition)
+                && Snapshot.bPlayingMatchedTransition;
+        }
+        else
+        {
+            StopAnimationDirect();
+        }
+    }
+
+    if (CurrentAnimation && GetMesh() && !bIsLeanServer)
+    {
+        GetMesh()->SetPosition(Snapshot.AnimationPosition, false);
+    }
+}
+
+const FSarahMovementSnapshot* ASarahCharacter::GetMovementSnapshotFramesAgo(int32 FramesAgo) const
+{
+    if (FramesAgo < 0 || FramesAgo >= SnapshotHistoryCount)
+    {
+        return nullptr;
+    }
+
+    const int32 Capacity = SnapshotHistory.Num();
+    const int32 Index = (SnapshotHistoryHead - 1 - FramesAgo + Capacity) % Capacity;
+    return &SnapshotHistory[Index];
+}
+
+bool ASarahCharacter::RestoreMovementSnapshotFramesAgo(int32 FramesAgo)
+{
+    const FSarahMovementSnapshot* Snapshot = GetMovementSnapshotFramesAgo(FramesAgo);
+    if (!Snapshot) return false;
+
+    RestoreMovementSnapshot(*Snapshot);
+
+    // The undone frames belong to a discarded timeline
+    const int32 Capacity = SnapshotHistory.Num();
+    SnapshotHistoryHead = (SnapshotHistoryHead - FramesAgo + Capacity) % Capacity;
+    SnapshotHistoryCount -= FramesAgo;
+    return true;
+}
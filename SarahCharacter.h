@@ -8,8 +8,14 @@
 #include "EnhancedInput/Public/InputMappingContext.h"
 #include "EnhancedInput/Public/InputAction.h"
 #include "Animation/AnimSequence.h"
+#include "Sarah/SarahInputSource.h"
 #include "SarahCharacter.generated.h"
 
+class USarahMovementComponent;
+class USarahPoseDatabase;
+
+DECLARE_STATS_GROUP(TEXT("Sarah"), STATGROUP_Sarah, STATCAT_Advanced);
+
 UENUM(BlueprintType)
 enum class ESarahMovementState : uint8
 {
@@ -20,15 +26,71 @@ enum class ESarahMovementState : uint8
     Landing
 };
 
+class ASarahCharacter;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FSarahMovementStateChangedSignature, ASarahCharacter*, Character, ESarahMovementState, PreviousState, ESarahMovementState, NewState);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSarahSprintChangedSignature, ASarahCharacter*, Character, bool, bIsSprinting);
+
+// Complete runtime movement state of one Sarah. Plain data so it can be
+// copied into preallocated history buffers without allocating.
+struct FSarahMovementSnapshot
+{
+    // State machine
+    ESarahMovementState CurrentState;
+    ESarahMovementState PreviousState;
+
+    // Input
+    FVector2D MoveInput;
+    bool bIsSprinting;
+
+    // Camera-relative movement and continuous angle
+    float CurrentCameraYaw;
+    float LockedCameraYaw;
+    bool bUsingCameraRelativeMovement;
+    float CurrentMovementAngle;
+    float TargetMovementAngle;
+    bool bIsTransitioningAngle;
+    float AvoidanceYawOffset;
+
+    // Fixed-step simulation
+    float SimulationAccumulator;
+    float SimulatedYaw;
+    float PreviousSimulatedYaw;
+    bool bHasSimulatedRotation;
+
+    // Jump and landing
+    bool bJumpStartCompleted;
+    bool bIsFalling;
+    float JumpStartTime;
+    float PreviousZVelocity;
+    float LandingStartTime;
+    bool bLandingAnimationCompleted;
+    bool bLandingStateActive;
+
+    // Movement speed set by the current state
+    float MaxWalkSpeed;
+
+    // Animation; weak because history rings are not seen by the garbage collector
+    TWeakObjectPtr<UAnimSequence> CurrentAnimation;
+    float AnimationPosition;
+
+    // Pose matching; a matched start/stop clip restores as a one-shot
+    bool bPlayingMatchedTransition;
+    float LastPoseMatchAngle;
+};
+
 UCLASS()
 class SARAH_API ASarahCharacter : public ACharacter
 {
     GENERATED_BODY()
 
 public:
-    ASarahCharacter();
+    ASarahCharacter(const FObjectInitializer& ObjectInitializer);
 
-    // Camera Components
+    // Movement component that owns rotation
+    USarahMovementComponent* GetSarahMovement() const;
+
+    // Camera Components; optional, so subclasses may drop them and they can be null
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera")
     USpringArmComponent* CameraBoom;
 
@@ -58,9 +120,42 @@ public:
     UFUNCTION(BlueprintPure, Category = "SarahFSM")
     bool SarahIsLanding() const { return CurrentState == ESarahMovementState::Landing; }
 
+    UFUNCTION(BlueprintPure, Category = "SarahFSM")
+    ESarahMovementState GetSarahMovementState() const { return CurrentState; }
+
+    UFUNCTION(BlueprintPure, Category = "SarahFSM")
+    ESarahMovementState GetSarahPreviousMovementState() const { return PreviousState; }
+
+    // Push-style alternative to polling the getters above. Fired before the new
+    // state's Enter logic, so transitions chained from Enter arrive in order.
+    UPROPERTY(BlueprintAssignable, Category = "SarahFSM")
+    FSarahMovementStateChangedSignature OnSarahMovementStateChanged;
+
+    UPROPERTY(BlueprintAssignable, Category = "SarahFSM")
+    FSarahSprintChangedSignature OnSarahSprintChanged;
+
+    // Also queue changes on USarahStateEventSubsystem, which broadcasts them once per frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SarahFSM")
+    bool bBatchStateEvents = false;
+
     UFUNCTION(BlueprintCallable, Category = "Sarah|Movement")
     FString GetMovementDirectionName() const;
 
+    // Non-allocating variant of GetMovementDirectionName; false means "None"
+    UFUNCTION(BlueprintPure, Category = "Sarah|Movement")
+    bool GetMovementDirectionAngle(float& OutAngle) const;
+
+    // One-line state summary for debug drawing; returns the length written
+    int32 WriteDebugSummary(TCHAR* Buffer, int32 BufferSize) const;
+
+    // Every Sarah between BeginPlay and EndPlay, across all worlds
+    static const TArray<ASarahCharacter*>& GetActiveSarahs();
+
+    // Time every Sarah has spent in camera, movement and state machine updates
+    // since the last reset. Always zero in shipping builds.
+    static uint64 GetMovementUpdateCycles();
+    static void ResetMovementUpdateCycles();
+
     // Movement state getters
     UFUNCTION(BlueprintPure, Category = "Sarah|Movement")
     FVector2D GetSarahMoveInput() const { return MoveInput; }
@@ -68,10 +163,78 @@ public:
     UFUNCTION(BlueprintPure, Category = "Sarah|Movement")
     bool GetSarahIsSprinting() const { return bIsSprinting; }
 
+    // Scripted input (routed through the same handlers as Enhanced Input)
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Input")
+    void SetSarahMoveInput(FVector2D Input);
+
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Input")
+    void SetSarahIsSprinting(bool bSprint);
+
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Input")
+    void SarahJump();
+
+    // Pluggable input source; nullptr means the Enhanced Input handlers drive Sarah
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Input")
+    void SetSarahInputSource(TScriptInterface<ISarahInputSource> NewInputSource);
+
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Input")
+    void ApplyMovementIntent(const FSarahMovementIntent& Intent);
+
+    // Inverse of the continuous input angle: MoveInput that walks along a world direction
+    UFUNCTION(BlueprintPure, Category = "Sarah|Input")
+    FVector2D MakeMoveInputFromWorldDirection(FVector WorldDirection) const;
+
+    // Pure movement math, shared by the FSM and USarahTuningSweepCommandlet
+    static bool IsMoveInputActive(FVector2D Input);
+    static float InputToWorldAngle(FVector2D Input, float ReferenceYaw);
+    static float FindShortestAnglePath(float CurrentAngle, float TargetAngle);
+    static bool StepContinuousAngle(float& InOutAngle, float TargetAngle, float RotationSpeed, float DeltaTime);
+    static ESarahMovementState GetLocomotionTransition(ESarahMovementState State, bool bHasInput, bool bSprinting);
+
     // Configurable properties
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Movement")
     float ContinuousRotationSpeed = 8.0f;
 
+    // Fixed-step simulation: angle, FSM and rotation run at SimulationStepRate
+    // and the visible rotation is interpolated between steps
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Simulation")
+    bool bUseFixedSimulationStep = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Simulation", meta = (ClampMin = "1.0", EditCondition = "bUseFixedSimulationStep"))
+    float SimulationStepRate = 30.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Simulation", meta = (ClampMin = "1", EditCondition = "bUseFixedSimulationStep"))
+    int32 MaxSimulationStepsPerFrame = 4;
+
+    // Local avoidance against other Sarahs through a shared spatial hash
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Avoidance")
+    bool bUseLocalAvoidance = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Avoidance", meta = (ClampMin = "0.0", EditCondition = "bUseLocalAvoidance"))
+    float AvoidanceRadius = 150.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Avoidance", meta = (ClampMin = "0.0", EditCondition = "bUseLocalAvoidance"))
+    float AvoidanceWeight = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Avoidance", meta = (ClampMin = "0.0", ClampMax = "90.0", EditCondition = "bUseLocalAvoidance"))
+    float MaxAvoidanceAngle = 45.0f;
+
+    // Frames of movement snapshots kept for rollback and rewind, 0 disables recording.
+    // Read at BeginPlay.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sarah|Simulation", meta = (ClampMin = "0"))
+    int32 SnapshotHistoryLength = 0;
+
+    // Snapshot save/restore (no allocation)
+    void SaveMovementSnapshot(FSarahMovementSnapshot& OutSnapshot) const;
+    void RestoreMovementSnapshot(const FSarahMovementSnapshot& Snapshot);
+
+    // 0 is the snapshot recorded at the end of the last tick
+    const FSarahMovementSnapshot* GetMovementSnapshotFramesAgo(int32 FramesAgo) const;
+
+    // Rewinds to that frame and drops the newer ones, which then becomes FramesAgo 0
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Simulation")
+    bool RestoreMovementSnapshotFramesAgo(int32 FramesAgo);
+
     // Animation assets
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Animation")
     UAnimSequence* IdleAnimation;
@@ -91,8 +254,33 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Animation")
     UAnimSequence* LandingAnimation;
 
+    // Motion-matched starts, stops and pivots; falls back to the fixed clips when unset
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Animation")
+    USarahPoseDatabase* PoseDatabase;
+
+    // Target direction change (degrees) that triggers a new pose query while moving
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Animation", meta = (ClampMin = "0.0"))
+    float PoseMatchAngleThreshold = 45.0f;
+
+    // Register the mesh with the animation budget allocator (a.Budget.BudgetMs sets the cap)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Animation")
+    bool bUseAnimationBudget = false;
+
+    // Budget significance per state; higher keeps a fuller update rate under load
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Animation", meta = (EditCondition = "bUseAnimationBudget"))
+    TMap<ESarahMovementState, float> AnimationStateSignificance;
+
+    // Idle/Walk/Run copy their pose from shared leader meshes; Jump and Landing stay per character
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Animation")
+    bool bUseSharedAnimation = false;
+
+    // Leaders per state, each started at a different phase
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Animation", meta = (ClampMin = "1", EditCondition = "bUseSharedAnimation"))
+    int32 SharedAnimationPhaseBuckets = 4;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
     virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -130,6 +318,15 @@ protected:
     float BaseLookUpRate = 45.0f;
 
 private:
+    // Reads tuning defaults for offline sweeps
+    friend class USarahTuningSweepCommandlet;
+
+    UPROPERTY()
+    TScriptInterface<ISarahInputSource> InputSource;
+
+    // Dedicated server build: idle camera components, no animation or input assets
+    bool bIsLeanServer;
+
     // Core state machine
     ESarahMovementState CurrentState;
     ESarahMovementState PreviousState;
@@ -151,6 +348,21 @@ private:
     float CurrentMovementAngle;
     float TargetMovementAngle;
     bool bIsTransitioningAngle;
+    float AvoidanceYawOffset;
+
+    // Fixed-step simulation
+    float SimulationAccumulator;
+    float SimulatedYaw;
+    float PreviousSimulatedYaw;
+    bool bHasSimulatedRotation;
+
+    // Local avoidance
+    int32 AvoidanceAgentHandle;
+
+    // Snapshot history ring buffer
+    TArray<FSarahMovementSnapshot> SnapshotHistory;
+    int32 SnapshotHistoryHead;
+    int32 SnapshotHistoryCount;
 
     // Jump state variables
     bool bJumpStartCompleted;
@@ -159,6 +371,13 @@ private:
     float JumpAnimationLength;
     float PreviousZVelocity;
 
+    // Pose matching; a matched start/stop clip plays once, then the state's loop takes over
+    float LastPoseMatchAngle;
+    bool bPlayingMatchedTransition;
+
+    // Animation budget
+    bool bRegisteredWithAnimationBudget;
+
     // Landing state variables
     float LandingStartTime;
     float LandingAnimationLength;
@@ -196,21 +415,34 @@ private:
 
     // Movement functions
     void UpdateMovement(float DeltaTime);
+    void ApplyMovementInput();
+    void TickFixedSimulation(float DeltaTime);
     FVector CalculateCameraRelativeDirection(float CameraYaw, FVector2D Input) const;
     bool StartCameraRelativeMovement();
     void StopCameraRelativeMovement();
     FVector GetMovementDirection() const;
-    void UpdateCharacterRotation();
+    void UpdateCharacterRotation(float DeltaTime);
+    void ApplyFacingYaw(float Yaw);
+    void BroadcastSprintChanged();
     bool HasMovementInput() const;
 
     // Continuous angle system
     float CalculateContinuousInputAngle() const;
     void UpdateContinuousMovementAngle(float DeltaTime);
-    float FindShortestAnglePath(float CurrentAngle, float TargetAngle) const;
+
+    // Local avoidance
+    void UpdateLocalAvoidance(float DeltaTime);
 
     // Animation functions
-    bool PlayAnimationInternal(UAnimSequence* Animation);
+    bool PlayAnimationInternal(UAnimSequence* Animation, bool bLooping = true);
     bool PlayAnimationWithSpeed(UAnimSequence* Animation, float Speed);
+    bool TryPlaySharedAnimation(UAnimSequence* Animation);
+    UAnimSequence* GetStateLoopAnimation() const;
+    bool PlayMatchedPose(float DesiredSpeed);
+    void UpdatePoseMatchedPivot(float DesiredSpeed);
+    void UpdateMatchedTransition();
+    void LeaveSharedAnimation();
+    void UpdateAnimationBudgetSignificance();
     void SetMovementSpeed(float Speed);
 
     // Camera functions
@@ -0,0 +1,518 @@
+#include "Sarah/SarahCharacter.h"
+#include "Sarah/SarahStateRecorder.h"
+#include "Sarah/SarahMovementComponent.h"
+#include "Sarah/SarahPoseDatabase.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Animation/AnimSingleNodeInstance.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace SarahTests
+{
+    constexpr float FrameSeconds = 1.0f / 60.0f;
+
+    // Throwaway game world with a flat floor, ticked by hand
+    class FTestWorld
+    {
+    public:
+        FTestWorld()
+        {
+            World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SarahTestWorld"));
+            FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+            WorldContext.SetCurrentWorld(World);
+
+            World->InitializeActorsForPlay(FURL());
+            World->BeginPlay();
+
+            // 10000uu square, top face at Z = 0
+            if (UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")))
+            {
+                AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.0f, 0.0f, -50.0f), FRotator::ZeroRotator);
+                Floor->GetStaticMeshComponent()->SetStaticMesh(Cube);
+                Floor->SetActorScale3D(FVector(100.0f, 100.0f, 1.0f));
+            }
+        }
+
+        ~FTestWorld()
+        {
+            GEngine->DestroyWorldContext(World);
+            World->DestroyWorld(false);
+        }
+
+        ASarahCharacter* SpawnSarah(const FVector2D& Location, int32 SnapshotHistoryLength = 0)
+        {
+            const float HalfHeight = GetDefault<ASarahCharacter>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+            const FTransform SpawnTransform(FVector(Location, HalfHeight + 2.0f));
+
+            // Deferred so BeginPlay sees the history length
+            ASarahCharacter* Sarah = World->SpawnActorDeferred<ASarahCharacter>(ASarahCharacter::StaticClass(), SpawnTransform,
+                nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+            if (Sarah)
+            {
+                Sarah->SnapshotHistoryLength = SnapshotHistoryLength;
+                Sarah->FinishSpawning(SpawnTransform);
+
+                // The movement component only simulates possessed pawns
+                Sarah->SpawnDefaultController();
+            }
+            return Sarah;
+        }
+
+        // Square grid, 200uu apart
+        void SpawnSarahs(int32 Count, TArray<ASarahCharacter*>& OutSarahs)
+        {
+            const int32 Side = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                const FVector2D Location((Index % Side - Side / 2) * 200.0f, (Index / Side - Side / 2) * 200.0f);
+                if (ASarahCharacter* Sarah = SpawnSarah(Location))
+                {
+                    OutSarahs.Add(Sarah);
+                }
+            }
+        }
+
+        void Tick(int32 Frames = 1)
+        {
+            for (int32 Frame = 0; Frame < Frames; ++Frame)
+            {
+                World->Tick(LEVELTICK_All, FrameSeconds);
+            }
+        }
+
+        UWorld* World = nullptr;
+    };
+
+    // One recorder per Sarah, bound to its state change delegate
+    static void WatchSarahs(const TArray<ASarahCharacter*>& Sarahs, TArray<TStrongObjectPtr<USarahStateRecorder>>& OutRecorders)
+    {
+        for (ASarahCharacter* Sarah : Sarahs)
+        {
+            TStrongObjectPtr<USarahStateRecorder>& Recorder = OutRecorders.Emplace_GetRef(NewObject<USarahStateRecorder>());
+            Recorder->Watch(Sarah);
+        }
+    }
+
+    static bool EndsIn(const USarahStateRecorder* Recorder, ESarahMovementState State)
+    {
+        return Recorder->GetEdges().Num() > 0 && Recorder->GetEdges().Last().To == State;
+    }
+
+    // Clip the mesh is playing on its own, and whether it loops
+    static UAnimSequence* GetPlayingAnimation(const ASarahCharacter* Sarah, bool& bOutLooping)
+    {
+        const UAnimSingleNodeInstance* Instance = Sarah->GetMesh()->GetSingleNodeInstance();
+        bOutLooping = Instance && Instance->IsLooping();
+        return Instance ? Cast<UAnimSequence>(Instance->GetAnimationAsset()) : nullptr;
+    }
+
+    constexpr int32 SequenceSarahCount = 8;
+    constexpr int32 SettleFrames = 30;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSarahLocomotionSequenceTest, "Sarah.FSM.IdleWalkRunIdle",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSarahLocomotionSequenceTest::RunTest(const FString& Parameters)
+{
+    using namespace SarahTests;
+
+    FTestWorld TestWorld;
+    TArray<ASarahCharacter*> Sarahs;
+    TestWorld.SpawnSarahs(SequenceSarahCount, Sarahs);
+    TestEqual(TEXT("Spawned Sarahs"), Sarahs.Num(), SequenceSarahCount);
+    TestWorld.Tick(SettleFrames);
+
+    TArray<TStrongObjectPtr<USarahStateRecorder>> Recorders;
+    WatchSarahs(Sarahs, Recorders);
+    for (ASarahCharacter* Sarah : Sarahs)
+    {
+        TestTrue(TEXT("Starts in Idle"), Sarah->SarahIsIdle());
+        Sarah->SetSarahMoveInput(FVector2D(0.0f, 1.0f));
+    }
+    TestWorld.Tick(10);
+
+    for (ASarahCharacter* Sarah : Sarahs)
+    {
+        Sarah->SetSarahIsSprinting(true);
+    }
+    TestWorld.Tick(10);
+
+    for (ASarahCharacter* Sarah : Sarahs)
+    {
+        Sarah->SetSarahMoveInput(FVector2D::ZeroVector);
+        Sarah->SetSarahIsSprinting(false);
+    }
+    TestWorld.Tick(10);
+
+    const FString Expected = USarahStateRecorder::DescribeEdges({
+        { ESarahMovementState::Idle, ESarahMovementState::Walk },
+        { ESarahMovementState::Walk, ESarahMovementState::Run },
+        { ESarahMovementState::Run, ESarahMovementState::Idle } });
+    for (const TStrongObjectPtr<USarahStateRecorder>& Recorder : Recorders)
+    {
+        TestEqual(TEXT("Idle -> Walk -> Run -> Idle"), Recorder->DescribeEdges(), Expected);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSarahJumpSequenceTest, "Sarah.FSM.IdleJumpLandingIdle",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSarahJumpSequenceTest::RunTest(const FString& Parameters)
+{
+    using namespace SarahTests;
+
+    FTestWorld TestWorld;
+    TArray<ASarahCharacter*> Sarahs;
+    TestWorld.SpawnSarahs(SequenceSarahCount, Sarahs);
+    TestEqual(TEXT("Spawned Sarahs"), Sarahs.Num(), SequenceSarahCount);
+    TestWorld.Tick(SettleFrames);
+
+    TArray<TStrongObjectPtr<USarahStateRecorder>> Recorders;
+    WatchSarahs(Sarahs, Recorders);
+    for (ASarahCharacter* Sarah : Sarahs)
+    {
+        TestTrue(TEXT("On the floor before jumping"), Sarah->GetCharacterMovement()->IsMovingOnGround());
+        Sarah->SarahJump();
+    }
+
+    // Jump, fall and landing clip all fit in five seconds
+    for (int32 Frame = 0; Frame < 300; ++Frame)
+    {
+        TestWorld.Tick();
+
+        bool bAllBack = true;
+        for (const TStrongObjectPtr<USarahStateRecorder>& Recorder : Recorders)
+        {
+            bAllBack &= EndsIn(Recorder.Get(), ESarahMovementState::Idle);
+        }
+        if (bAllBack) break;
+    }
+
+    // Landing -> Idle is chained from EnterLanding when there is no landing
+    // clip, and must still arrive after Jump -> Landing
+    const FString Expected = USarahStateRecorder::DescribeEdges({
+        { ESarahMovementState::Idle, ESarahMovementState::Jump },
+        { ESarahMovementState::Jump, ESarahMovementState::Landing },
+        { ESarahMovementState::Landing, ESarahMovementState::Idle } });
+    for (const TStrongObjectPtr<USarahStateRecorder>& Recorder : Recorders)
+    {
+        TestEqual(TEXT("Idle -> Jump -> Landing -> Idle"), Recorder->DescribeEdges(), Expected);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSarahAsyncFloorProbeTest, "Sarah.Movement.AsyncFloorProbe",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSarahAsyncFloorProbeTest::RunTest(const FString& Parameters)
+{
+    using namespace SarahTests;
+
+    FTestWorld TestWorld;
+    TArray<ASarahCharacter*> Sarahs;
+    TestWorld.SpawnSarahs(SequenceSarahCount, Sarahs);
+    TestEqual(TEXT("Spawned Sarahs"), Sarahs.Num(), SequenceSarahCount);
+
+    // No players in the test world, so every AI-driven Sarah counts as far away
+    for (ASarahCharacter* Sarah : Sarahs)
+    {
+        Sarah->GetSarahMovement()->bUseAsyncFloorProbe = true;
+    }
+    TestWorld.Tick(SettleFrames);
+
+    TArray<TStrongObjectPtr<USarahStateRecorder>> Recorders;
+    WatchSarahs(Sarahs, Recorders);
+    for (ASarahCharacter* Sarah : Sarahs)
+    {
+        TestTrue(TEXT("Settled on the async floor"), Sarah->GetCharacterMovement()->IsMovingOnGround());
+        Sarah->SarahJump();
+    }
+
+    TArray<bool> ProbedInAir;
+    ProbedInAir.Init(false, Sarahs.Num());
+    for (int32 Frame = 0; Frame < 300; ++Frame)
+    {
+        TestWorld.Tick();
+
+        bool bAllBack = true;
+        for (int32 Index = 0; Index < Sarahs.Num(); ++Index)
+        {
+            const USarahMovementComponent* Movement = Sarahs[Index]->GetSarahMovement();
+            ProbedInAir[Index] |= Movement->IsFalling() && Movement->IsUsingAsyncFloorProbe();
+            bAllBack &= EndsIn(Recorders[Index].Get(), ESarahMovementState::Idle);
+        }
+        if (bAllBack) break;
+    }
+
+    // Landing is decided from the CMC, so the FSM sees the same sequence as with synchronous checks
+    const FString Expected = USarahStateRecorder::DescribeEdges({
+        { ESarahMovementState::Idle, ESarahMovementState::Jump },
+        { ESarahMovementState::Jump, ESarahMovementState::Landing },
+        { ESarahMovementState::Landing, ESarahMovementState::Idle } });
+    for (int32 Index = 0; Index < Sarahs.Num(); ++Index)
+    {
+        TestTrue(TEXT("Async probe used while falling"), ProbedInAir[Index]);
+        TestEqual(TEXT("Idle -> Jump -> Landing -> Idle"), Recorders[Index]->DescribeEdges(), Expected);
+    }
+
+    // Walking on last frame's floor keeps the capsule at the same height
+    TArray<float> StandingHeights;
+    for (ASarahCharacter* Sarah : Sarahs)
+    {
+        StandingHeights.Add(Sarah->GetActorLocation().Z);
+        Sarah->SetSarahMoveInput(FVector2D(0.0f, 1.0f));
+    }
+    TestWorld.Tick(60);
+
+    for (int32 Index = 0; Index < Sarahs.Num(); ++Index)
+    {
+        const ASarahCharacter* Sarah = Sarahs[Index];
+        TestTrue(TEXT("Still walking"), Sarah->GetCharacterMovement()->IsMovingOnGround());
+        TestTrue(TEXT("Async probe used while walking"), Sarah->GetSarahMovement()->IsUsingAsyncFloorProbe());
+        TestEqual(TEXT("Standing height"), static_cast<float>(Sarah->GetActorLocation().Z), StandingHeights[Index], 1.0f);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSarahMatchedTransitionTest, "Sarah.Animation.MatchedTransitions",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSarahMatchedTransitionTest::RunTest(const FString& Parameters)
+{
+    using namespace SarahTests;
+
+    // ASarahCharacter's default WalkSpeed, the root speed EnterWalk queries with
+    constexpr float WalkQuerySpeed = 200.0f;
+
+    FTestWorld TestWorld;
+    ASarahCharacter* Sarah = TestWorld.SpawnSarah(FVector2D::ZeroVector);
+    if (!TestNotNull(TEXT("Spawned Sarah"), Sarah)) return false;
+    if (!TestNotNull(TEXT("Idle loop"), Sarah->IdleAnimation) || !TestNotNull(TEXT("Walk loop"), Sarah->WalkAnimation)) return false;
+
+    // Just the two loops, each the best match for leaving its own state, so the
+    // matched clip is the one still playing when the next state is entered
+    USarahPoseDatabase* Database = NewObject<USarahPoseDatabase>(Sarah);
+    Database->Sequences = { Sarah->IdleAnimation, Sarah->WalkAnimation };
+    TArray<FSarahPoseFeature> Features;
+    Features.SetNum(2);
+    Features[0].SequenceIndex = 0;
+    Features[0].Values[0] = WalkQuerySpeed;
+    Features[1].SequenceIndex = 1;
+    Features[1].Values[0] = 0.0f;
+    Database->InitializeFeatures(MoveTemp(Features));
+    Sarah->PoseDatabase = Database;
+
+    TestWorld.Tick(SettleFrames);
+    bool bLooping = false;
+    TestTrue(TEXT("Idle loop before moving"), GetPlayingAnimation(Sarah, bLooping) == Sarah->IdleAnimation && bLooping);
+
+    // Start: the idle loop is replayed once as the start clip
+    Sarah->SetSarahMoveInput(FVector2D(0.0f, 1.0f));
+    TestWorld.Tick();
+    TestTrue(TEXT("Walking"), Sarah->SarahIsWalking());
+    TestTrue(TEXT("Matched start clip plays once"), GetPlayingAnimation(Sarah, bLooping) == Sarah->IdleAnimation && !bLooping);
+
+    // Finishing the start clip hands over to the walk loop
+    Sarah->GetMesh()->SetPosition(Sarah->IdleAnimation->GetPlayLength(), false);
+    TestWorld.Tick(2);
+    TestTrue(TEXT("Walk loop after the start clip"), GetPlayingAnimation(Sarah, bLooping) == Sarah->WalkAnimation && bLooping);
+
+    // Stop: the walk loop is replayed once as the stop clip
+    Sarah->SetSarahMoveInput(FVector2D::ZeroVector);
+    TestWorld.Tick();
+    TestTrue(TEXT("Idle"), Sarah->SarahIsIdle());
+    TestTrue(TEXT("Matched stop clip plays once"), GetPlayingAnimation(Sarah, bLooping) == Sarah->WalkAnimation && !bLooping);
+
+    FSarahMovementSnapshot MidStopClip;
+    Sarah->SaveMovementSnapshot(MidStopClip);
+
+    Sarah->GetMesh()->SetPosition(Sarah->WalkAnimation->GetPlayLength(), false);
+    TestWorld.Tick(2);
+    TestTrue(TEXT("Idle loop after the stop clip"), GetPlayingAnimation(Sarah, bLooping) == Sarah->IdleAnimation && bLooping);
+
+    // Rewinding into the stop clip resumes it as a one-shot
+    Sarah->RestoreMovementSnapshot(MidStopClip);
+    TestTrue(TEXT("Restored stop clip plays once"), GetPlayingAnimation(Sarah, bLooping) == Sarah->WalkAnimation && !bLooping);
+
+    Sarah->GetMesh()->SetPosition(Sarah->WalkAnimation->GetPlayLength(), false);
+    TestWorld.Tick(2);
+    TestTrue(TEXT("Restored stop clip hands back to the idle loop"), GetPlayingAnimation(Sarah, bLooping) == Sarah->IdleAnimation && bLooping);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSarahSnapshotRingTest, "Sarah.Simulation.SnapshotRing",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSarahSnapshotRingTest::RunTest(const FString& Parameters)
+{
+    using namespace SarahTests;
+
+    constexpr int32 HistoryLength = 8;
+    constexpr int32 FramesAgo = 3;
+
+    FTestWorld TestWorld;
+    ASarahCharacter* Sarah = TestWorld.SpawnSarah(FVector2D::ZeroVector, HistoryLength);
+    if (!TestNotNull(TEXT("Spawned Sarah"), Sarah)) return false;
+
+    // Turn right so every recorded frame has a different movement angle
+    TestWorld.Tick(SettleFrames);
+    Sarah->SetSarahMoveInput(FVector2D(1.0f, 0.0f));
+    TestWorld.Tick(HistoryLength * 2);
+
+    TestNotNull(TEXT("Oldest frame kept"), Sarah->GetMovementSnapshotFramesAgo(HistoryLength - 1));
+    TestNull(TEXT("Frames past the ring length"), Sarah->GetMovementSnapshotFramesAgo(HistoryLength));
+
+    const FSarahMovementSnapshot Target = *Sarah->GetMovementSnapshotFramesAgo(FramesAgo);
+    const FSarahMovementSnapshot BeforeTarget = *Sarah->GetMovementSnapshotFramesAgo(FramesAgo + 1);
+
+    TestTrue(TEXT("Restore succeeds"), Sarah->RestoreMovementSnapshotFramesAgo(FramesAgo));
+    TestTrue(TEXT("State restored"), Sarah->GetSarahMovementState() == Target.CurrentState);
+
+    // The undone frames are gone; the restored frame is now the newest
+    const FSarahMovementSnapshot* Newest = Sarah->GetMovementSnapshotFramesAgo(0);
+    const FSarahMovementSnapshot* Older = Sarah->GetMovementSnapshotFramesAgo(1);
+    if (TestNotNull(TEXT("Newest frame"), Newest) && TestNotNull(TEXT("Frame before it"), Older))
+    {
+        TestEqual(TEXT("Newest is the restored frame"), Newest->CurrentMovementAngle, Target.CurrentMovementAngle);
+        TestEqual(TEXT("Older frames keep their order"), Older->CurrentMovementAngle, BeforeTarget.CurrentMovementAngle);
+    }
+    TestNull(TEXT("Ring shrank by the rewound frames"), Sarah->GetMovementSnapshotFramesAgo(HistoryLength - FramesAgo));
+
+    // Recording continues from the restored frame
+    TestWorld.Tick();
+    const FSarahMovementSnapshot* Previous = Sarah->GetMovementSnapshotFramesAgo(1);
+    if (TestNotNull(TEXT("Restored frame after one tick"), Previous))
+    {
+        TestEqual(TEXT("Restored frame is one frame ago"), Previous->CurrentMovementAngle, Target.CurrentMovementAngle);
+    }
+    return true;
+}
+
+// Median per-frame cost of the Sarah movement and state machine updates with N
+// moving Sarahs, checked against SarahTickBudgetBaseline.csv. Physics and the
+// CMC are not counted. -SarahBudgetBaseline=<csv> reads another baseline;
+// -SarahBudgetUpdate rewrites it with this machine's numbers, which is how the
+// checked-in file is produced on the build agent; -SarahBudgetTolerance=0.15
+// is the allowed regression.
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FSarahTickBudgetTest, "Sarah.Performance.TickBudget",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FSarahTickBudgetTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    for (const TCHAR* Count : { TEXT("1"), TEXT("100"), TEXT("1000") })
+    {
+        OutBeautifiedNames.Add(FString::Printf(TEXT("%s Sarahs"), Count));
+        OutTestCommands.Add(Count);
+    }
+}
+
+bool FSarahTickBudgetTest::RunTest(const FString& Parameters)
+{
+    using namespace SarahTests;
+
+    const int32 Count = FCString::Atoi(*Parameters);
+
+    FString BaselinePath;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("SarahBudgetBaseline="), BaselinePath))
+    {
+        BaselinePath = FPaths::Combine(FPaths::GetPath(FString(ANSI_TO_TCHAR(__FILE__))), TEXT("SarahTickBudgetBaseline.csv"));
+    }
+
+    float Tolerance = 0.15f;
+    FParse::Value(FCommandLine::Get(), TEXT("SarahBudgetTolerance="), Tolerance);
+
+    // Count,Milliseconds rows
+    TArray<FString> Lines;
+    FFileHelper::LoadFileToStringArray(Lines, *BaselinePath);
+    TMap<int32, float> Baseline;
+    for (const FString& Line : Lines)
+    {
+        FString CountField, MsField;
+        if (Line.Split(TEXT(","), &CountField, &MsField) && CountField.IsNumeric())
+        {
+            Baseline.Add(FCString::Atoi(*CountField), FCString::Atof(*MsField));
+        }
+    }
+
+    FTestWorld TestWorld;
+    TArray<ASarahCharacter*> Sarahs;
+    TestWorld.SpawnSarahs(Count, Sarahs);
+    TestEqual(TEXT("Spawned Sarahs"), Sarahs.Num(), Count);
+    TestWorld.Tick(SettleFrames);
+
+    // Spread over every locomotion state and direction
+    for (int32 Index = 0; Index < Sarahs.Num(); ++Index)
+    {
+        const float Angle = Index * 2.399963f;
+        Sarahs[Index]->SetSarahMoveInput(Index % 3 == 0 ? FVector2D::ZeroVector : FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)));
+        Sarahs[Index]->SetSarahIsSprinting(Index % 3 == 2);
+    }
+    TestWorld.Tick(SettleFrames);
+
+    constexpr int32 MeasuredFrames = 120;
+    TArray<double> FrameMs;
+    FrameMs.Reserve(MeasuredFrames);
+    for (int32 Frame = 0; Frame < MeasuredFrames; ++Frame)
+    {
+        // Keep the FSM busy: a third of the crowd swaps sprint every half second
+        if (Frame % 30 == 0)
+        {
+            for (int32 Index = 1; Index < Sarahs.Num(); Index += 3)
+            {
+                Sarahs[Index]->SetSarahIsSprinting(!Sarahs[Index]->GetSarahIsSprinting());
+            }
+        }
+
+        ASarahCharacter::ResetMovementUpdateCycles();
+        TestWorld.Tick();
+        FrameMs.Add(FPlatformTime::ToMilliseconds64(ASarahCharacter::GetMovementUpdateCycles()));
+    }
+
+    // Median, so a single hitch on a shared agent does not fail the run
+    FrameMs.Sort();
+    const float UpdateMs = static_cast<float>(FrameMs[MeasuredFrames / 2]);
+
+    AddInfo(FString::Printf(TEXT("%d Sarahs: %.4f ms of movement update per frame"), Count, UpdateMs));
+
+    if (FParse::Param(FCommandLine::Get(), TEXT("SarahBudgetUpdate")))
+    {
+        Baseline.Add(Count, UpdateMs);
+        Baseline.KeySort(TLess<int32>());
+
+        FString Csv = TEXT("Characters,UpdateMs\n");
+        for (const TPair<int32, float>& Entry : Baseline)
+        {
+            Csv += FString::Printf(TEXT("%d,%.4f\n"), Entry.Key, Entry.Value);
+        }
+        TestTrue(TEXT("Baseline written"), FFileHelper::SaveStringToFile(Csv, *BaselinePath));
+        return true;
+    }
+
+    const float* BudgetMs = Baseline.Find(Count);
+    if (!BudgetMs)
+    {
+        AddError(FString::Printf(TEXT("No baseline for %d Sarahs in %s; record one on the build agent with -SarahBudgetUpdate"), Count, *BaselinePath));
+        return false;
+    }
+
+    TestTrue(FString::Printf(TEXT("%.4f ms within %.4f ms baseline +%d%%"), UpdateMs, *BudgetMs, FMath::RoundToInt(Tolerance * 100.0f)),
+        UpdateMs <= *BudgetMs * (1.0f + Tolerance));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
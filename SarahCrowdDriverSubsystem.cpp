@@ -0,0 +1,112 @@
+#include "Sarah/SarahCrowdDriverSubsystem.h"
+#include "Sarah/SarahCharacter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sarah Crowd Driver"), STAT_SarahCrowdDriver, STATGROUP_Sarah);
+
+void USarahCrowdDriverSubsystem::AddCharacter(ASarahCharacter* Character, FVector Goal, bool bSprint)
+{
+    if (!Character) return;
+
+    if (!MemberIndices.Contains(Character))
+    {
+        MemberIndices.Add(Character, Members.Num());
+        FCrowdMember& Member = Members.AddDefaulted_GetRef();
+        Member.Character = Character;
+        Member.Key = Character;
+    }
+
+    SetGoal(Character, Goal, bSprint);
+    Character->SetSarahInputSource(this);
+}
+
+void USarahCrowdDriverSubsystem::SetGoal(ASarahCharacter* Character, FVector Goal, bool bSprint)
+{
+    if (const int32* Index = MemberIndices.Find(Character))
+    {
+        FCrowdMember& Member = Members[*Index];
+        Member.Goal = Goal;
+        Member.bSprint = bSprint;
+        Member.bNeedsPath = true;
+    }
+}
+
+void USarahCrowdDriverSubsystem::RemoveCharacter(ASarahCharacter* Character)
+{
+    if (const int32* Index = MemberIndices.Find(Character))
+    {
+        RemoveMemberAt(*Index);
+        Character->SetSarahInputSource(nullptr);
+    }
+}
+
+void USarahCrowdDriverSubsystem::RemoveMemberAt(int32 Index)
+{
+    MemberIndices.Remove(Members[Index].Key);
+
+    const int32 LastIndex = Members.Num() - 1;
+    if (Index != LastIndex)
+    {
+        Members.Swap(Index, LastIndex);
+        MemberIndices.Add(Members[Index].Key, Index);
+    }
+    Members.RemoveAt(LastIndex, 1, false);
+}
+
+void USarahCrowdDriverSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SarahCrowdDriver);
+
+    UWorld* World = GetWorld();
+
+    // Round-robin path queries so a large goal change is spread over frames
+    int32 QueriesLeft = MaxPathQueriesPerFrame;
+    for (int32 Visited = 0; Visited < Members.Num() && QueriesLeft > 0; ++Visited)
+    {
+        NextPathQueryIndex = (NextPathQueryIndex + 1) % Members.Num();
+        FCrowdMember& Member = Members[NextPathQueryIndex];
+        ASarahCharacter* Character = Member.Character.Get();
+        if (Character && Member.bNeedsPath)
+        {
+            Member.Path.FindPath(World, Character->GetActorLocation(), Member.Goal, Character);
+            Member.bNeedsPath = false;
+            --QueriesLeft;
+        }
+    }
+
+    // Write every member's intent in one pass
+    for (int32 Index = Members.Num() - 1; Index >= 0; --Index)
+    {
+        FCrowdMember& Member = Members[Index];
+        ASarahCharacter* Character = Member.Character.Get();
+        if (!Character)
+        {
+            RemoveMemberAt(Index);
+            continue;
+        }
+
+        FVector Direction;
+        if (!Member.bNeedsPath && Member.Path.GetDirection(Character->GetActorLocation(), AcceptanceRadius, Direction))
+        {
+            Member.Intent.MoveInput = Character->MakeMoveInputFromWorldDirection(Direction);
+            Member.Intent.bSprint = Member.bSprint;
+        }
+        else
+        {
+            Member.Intent = FSarahMovementIntent();
+        }
+    }
+}
+
+TStatId USarahCrowdDriverSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USarahCrowdDriverSubsystem, STATGROUP_Tickables);
+}
+
+bool USarahCrowdDriverSubsystem::GatherMovementIntent(const ASarahCharacter* Character, FSarahMovementIntent& OutIntent)
+{
+    const int32* Index = MemberIndices.Find(Character);
+    if (!Index) return false;
+
+    OutIntent = Members[*Index].Intent;
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Sarah/SarahInputSource.h"
+#include "SarahCrowdDriverSubsystem.generated.h"
+
+// Writes movement intents for many Sarahs in one pass per frame. Members need
+// no PlayerController or input component; path queries are spread over frames.
+UCLASS()
+class SARAH_API USarahCrowdDriverSubsystem : public UTickableWorldSubsystem, public ISarahInputSource
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Crowd")
+    void AddCharacter(ASarahCharacter* Character, FVector Goal, bool bSprint);
+
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Crowd")
+    void SetGoal(ASarahCharacter* Character, FVector Goal, bool bSprint);
+
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Crowd")
+    void RemoveCharacter(ASarahCharacter* Character);
+
+    // Path queries allowed per frame across the whole crowd
+    int32 MaxPathQueriesPerFrame = 16;
+    float AcceptanceRadius = 50.0f;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    virtual bool GatherMovementIntent(const ASarahCharacter* Character, FSarahMovementIntent& OutIntent) override;
+
+private:
+    struct FCrowdMember
+    {
+        TWeakObjectPtr<ASarahCharacter> Character;
+
+        // Still valid after the character is gone, so its index entry can be removed
+        TObjectKey<ASarahCharacter> Key;
+        FVector Goal = FVector::ZeroVector;
+        FSarahPathCursor Path;
+        FSarahMovementIntent Intent;
+        bool bNeedsPath = true;
+        bool bSprint = false;
+    };
+
+    void RemoveMemberAt(int32 Index);
+
+    TArray<FCrowdMember> Members;
+    TMap<TObjectKey<ASarahCharacter>, int32> MemberIndices;
+    int32 NextPathQueryIndex = 0;
+};
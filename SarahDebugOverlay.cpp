@@ -0,0 +1,62 @@
+#include "Sarah/SarahCharacter.h"
+#include "CanvasItem.h"
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+// On-screen movement state for every Sarah. Characters come from the
+// BeginPlay/EndPlay registry rather than an actor iterator, and each line is
+// formatted into a fixed stack buffer and drawn as a string view, so drawing
+// does not touch the heap.
+namespace SarahDebugOverlay
+{
+    FDelegateHandle DrawHandle;
+
+    void Draw(UCanvas* Canvas, APlayerController* PlayerController)
+    {
+        if (!Canvas || !PlayerController) return;
+
+        UWorld* World = PlayerController->GetWorld();
+        const UFont* Font = GEngine->GetSmallFont();
+
+        TCHAR Buffer[256];
+        for (const ASarahCharacter* Character : ASarahCharacter::GetActiveSarahs())
+        {
+            // The registry spans PIE worlds
+            if (Character->GetWorld() != World) continue;
+
+            // Skip characters behind the view
+            const FVector ScreenLocation = Canvas->Project(Character->GetActorLocation() + FVector(0.0f, 0.0f, 110.0f));
+            if (ScreenLocation.Z <= 0.0f) continue;
+
+            const int32 Length = Character->WriteDebugSummary(Buffer, UE_ARRAY_COUNT(Buffer));
+
+            FCanvasTextStringViewItem TextItem(FVector2D(ScreenLocation.X, ScreenLocation.Y), FStringView(Buffer, Length), Font, FLinearColor::White);
+            TextItem.EnableShadow(FLinearColor::Black);
+            Canvas->DrawItem(TextItem);
+        }
+    }
+
+    void OnOverlayChanged(IConsoleVariable* Variable)
+    {
+        const bool bEnable = Variable->GetInt() != 0;
+        if (bEnable && !DrawHandle.IsValid())
+        {
+            DrawHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateStatic(&Draw));
+        }
+        else if (!bEnable && DrawHandle.IsValid())
+        {
+            UDebugDrawService::Unregister(DrawHandle);
+            DrawHandle.Reset();
+        }
+    }
+}
+
+static TAutoConsoleVariable<int32> CVarSarahDebugOverlay(
+    TEXT("sarah.Debug.Overlay"),
+    0,
+    TEXT("Draw state, angle, speed, sprint and jump phase above every Sarah."),
+    FConsoleVariableDelegate::CreateStatic(&SarahDebugOverlay::OnOverlayChanged),
+    ECVF_Cheat);
@@ -0,0 +1,95 @@
+#include "Sarah/SarahInputSource.h"
+#include "Sarah/SarahCharacter.h"
+#include "NavigationSystem.h"
+#include "NavigationPath.h"
+
+bool FSarahPathCursor::FindPath(UWorld* World, const FVector& Start, const FVector& Goal, AActor* Querier)
+{
+    Reset();
+
+    UNavigationPath* NavPath = UNavigationSystemV1::FindPathToLocationSynchronously(World, Start, Goal, Querier);
+    if (!NavPath || !NavPath->IsValid() || NavPath->PathPoints.Num() == 0)
+    {
+        return false;
+    }
+
+    Points = NavPath->PathPoints;
+
+    // First point is the start location
+    PointIndex = Points.Num() > 1 ? 1 : 0;
+    return true;
+}
+
+void FSarahPathCursor::Reset()
+{
+    Points.Reset();
+    PointIndex = 0;
+}
+
+bool FSarahPathCursor::GetDirection(const FVector& Location, float AcceptanceRadius, FVector& OutDirection)
+{
+    const float AcceptanceRadiusSq = FMath::Square(AcceptanceRadius);
+    while (Points.IsValidIndex(PointIndex) && FVector::DistSquared2D(Location, Points[PointIndex]) <= AcceptanceRadiusSq)
+    {
+        ++PointIndex;
+    }
+
+    if (!Points.IsValidIndex(PointIndex))
+    {
+        return false;
+    }
+
+    OutDirection = (Points[PointIndex] - Location).GetSafeNormal2D();
+    return true;
+}
+
+void USarahPathInputComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (ASarahCharacter* Character = Cast<ASarahCharacter>(GetOwner()))
+    {
+        Character->SetSarahInputSource(this);
+    }
+}
+
+bool USarahPathInputComponent::MoveToLocation(FVector Goal, bool bSprint)
+{
+    AActor* Owner = GetOwner();
+    if (!Owner) return false;
+
+    bFollowingPath = Path.FindPath(GetWorld(), Owner->GetActorLocation(), Goal, Owner);
+    bSprintOnPath = bSprint;
+    return bFollowingPath;
+}
+
+void USarahPathInputComponent::StopMovement()
+{
+    Path.Reset();
+    bFollowingPath = false;
+}
+
+bool USarahPathInputComponent::GatherMovementIntent(const ASarahCharacter* Character, FSarahMovementIntent& OutIntent)
+{
+    FVector Direction;
+    if (bFollowingPath && Path.GetDirection(Character->GetActorLocation(), AcceptanceRadius, Direction))
+    {
+        OutIntent.MoveInput = Character->MakeMoveInputFromWorldDirection(Direction);
+        OutIntent.bSprint = bSprintOnPath;
+        bDrivingInput = true;
+        return true;
+    }
+
+    bFollowingPath = false;
+
+    // Idle: leave the input to the player bindings or whoever else sets it
+    if (!bDrivingInput)
+    {
+        return false;
+    }
+
+    // Arrived or stopped: release input once
+    bDrivingInput = false;
+    OutIntent = FSarahMovementIntent();
+    return true;
+}
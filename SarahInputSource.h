@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Components/ActorComponent.h"
+#include "SarahInputSource.generated.h"
+
+class ASarahCharacter;
+
+// Movement intent in the same form as the Enhanced Input handlers receive it
+USTRUCT(BlueprintType)
+struct FSarahMovementIntent
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Input")
+    FVector2D MoveInput = FVector2D::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Input")
+    bool bSprint = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Input")
+    bool bJump = false;
+};
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class USarahInputSource : public UInterface
+{
+    GENERATED_BODY()
+};
+
+// Pluggable input for ASarahCharacter. A character with no input source is
+// driven by its Enhanced Input handlers (player input).
+class SARAH_API ISarahInputSource
+{
+    GENERATED_BODY()
+
+public:
+    // Called once per character tick; return false to leave the current input untouched
+    virtual bool GatherMovementIntent(const ASarahCharacter* Character, FSarahMovementIntent& OutIntent) = 0;
+};
+
+// Navmesh path and the point currently being walked towards
+struct SARAH_API FSarahPathCursor
+{
+    TArray<FVector> Points;
+    int32 PointIndex = 0;
+
+    bool FindPath(UWorld* World, const FVector& Start, const FVector& Goal, AActor* Querier);
+    void Reset();
+
+    // Advances past reached points; returns false once the end of the path is reached
+    bool GetDirection(const FVector& Location, float AcceptanceRadius, FVector& OutDirection);
+};
+
+// Drives its owning Sarah along navmesh paths, for AI controllers and scripted NPCs
+UCLASS(ClassGroup = (Sarah), meta = (BlueprintSpawnableComponent))
+class SARAH_API USarahPathInputComponent : public UActorComponent, public ISarahInputSource
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Input")
+    bool MoveToLocation(FVector Goal, bool bSprint);
+
+    UFUNCTION(BlueprintCallable, Category = "Sarah|Input")
+    void StopMovement();
+
+    UFUNCTION(BlueprintPure, Category = "Sarah|Input")
+    bool IsFollowingPath() const { return bFollowingPath; }
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Input")
+    float AcceptanceRadius = 50.0f;
+
+    virtual bool GatherMovementIntent(const ASarahCharacter* Character, FSarahMovementIntent& OutIntent) override;
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    FSarahPathCursor Path;
+    bool bFollowingPath = false;
+    bool bSprintOnPath = false;
+
+    // Set while our intent is applied, so arrival releases the input exactly once
+    bool bDrivingInput = false;
+};
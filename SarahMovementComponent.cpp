@@ -0,0 +1,268 @@
+#include "Sarah/SarahMovementComponent.h"
+#include "Sarah/SarahCharacter.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sarah Idle Sleeping"), STAT_SarahIdleSleeping, STATGROUP_Sarah);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sarah Async Floor Checks"), STAT_SarahAsyncFloorChecks, STATGROUP_Sarah);
+
+namespace SarahFloorProbe
+{
+    // Same capsule shrink as UCharacterMovementComponent::ComputeFloorDist
+    constexpr float ShrinkScale = 0.9f;
+
+    // Horizontal drift, as a fraction of the capsule radius, over which last frame's sweep still applies
+    constexpr float MaxDrift = 0.5f;
+}
+
+void USarahMovementComponent::SetDesiredFacingYaw(float Yaw, float InterpSpeed)
+{
+    // Same interpolated target while asleep: nothing to do. Snap targets are
+    // applied exactly, since fixed-step presentation sends small steps every frame.
+    if (bRotationAsleep && bHasFacingTarget && InterpSpeed > 0.0f && InterpSpeed == FacingInterpSpeed &&
+        FMath::Abs(FRotator::NormalizeAxis(Yaw - DesiredFacingYaw)) <= RotationSleepTolerance)
+    {
+        return;
+    }
+
+    DesiredFacingYaw = Yaw;
+    FacingInterpSpeed = InterpSpeed;
+    bHasFacingTarget = true;
+    bRotationAsleep = false;
+}
+
+void USarahMovementComponent::PhysicsRotation(float DeltaTime)
+{
+    // Nobody has asked for a facing yet, keep stock behaviour
+    if (!bHasFacingTarget)
+    {
+        Super::PhysicsRotation(DeltaTime);
+        return;
+    }
+
+    if (bRotationAsleep || !UpdatedComponent)
+    {
+        return;
+    }
+
+    const FRotator CurrentRotation = UpdatedComponent->GetComponentRotation();
+    const float YawError = FRotator::NormalizeAxis(DesiredFacingYaw - CurrentRotation.Yaw);
+
+    float NewYaw = DesiredFacingYaw;
+    if (FacingInterpSpeed > 0.0f && FMath::Abs(YawError) > RotationSleepTolerance)
+    {
+        NewYaw = FMath::RInterpTo(CurrentRotation, FRotator(0.0f, DesiredFacingYaw, 0.0f), DeltaTime, FacingInterpSpeed).Yaw;
+    }
+    else
+    {
+        // Final snap, then stop touching the transform until the target changes
+        bRotationAsleep = true;
+        if (FMath::IsNearlyZero(YawError) && FMath::IsNearlyZero(CurrentRotation.Pitch) && FMath::IsNearlyZero(CurrentRotation.Roll))
+        {
+            return;
+        }
+    }
+
+    // Only rotate around Z axis (yaw)
+    MoveUpdatedComponent(FVector::ZeroVector, FRotator(0.0f, NewYaw, 0.0f), false);
+}
+
+void USarahMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    if (bEnableIdleFastPath && CanSleepIdle())
+    {
+        if (++SettledFrameCount >= IdleSettleFrames)
+        {
+            if (!bIdleAsleep)
+            {
+                bIdleAsleep = true;
+                SleepLocation = UpdatedComponent->GetComponentLocation();
+                SleepBase = CharacterOwner->GetMovementBase();
+                SleepBaseTransform = SleepBase.IsValid() ? SleepBase->GetComponentTransform() : FTransform::Identity;
+            }
+
+            // Nothing to move and the floor cannot have changed: skip the walking update
+            INC_DWORD_STAT(STAT_SarahIdleSleeping);
+            return;
+        }
+    }
+    else
+    {
+        SettledFrameCount = 0;
+        bIdleAsleep = false;
+    }
+
+    ReadAsyncFloorProbe();
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    SubmitAsyncFloorProbe(DeltaTime);
+}
+
+bool USarahMovementComponent::CanSleepIdle() const
+{
+    if (!CharacterOwner || !UpdatedComponent) return false;
+
+    // Autonomous proxies must keep sending moves and remote players are driven by RPCs
+    if (CharacterOwner->GetLocalRole() != ROLE_Authority) return false;
+    if (CharacterOwner->IsPlayerControlled() && !CharacterOwner->IsLocallyControlled()) return false;
+
+    // Grounded, still and settled on a walkable floor
+    if (MovementMode != MOVE_Walking || !CurrentFloor.IsWalkableFloor()) return false;
+    if (!Velocity.IsNearlyZero()) return false;
+    if (!bRotationAsleep) return false;
+
+    // Input and external forces wake us up
+    if (!CharacterOwner->GetPendingMovementInputVector().IsNearlyZero()) return false;
+    if (!PendingImpulseToApply.IsNearlyZero() || !PendingForceToApply.IsNearlyZero() || !PendingLaunchVelocity.IsNearlyZero()) return false;
+    if (bHasRequestedVelocity || HasRootMotionSources() || CharacterOwner->IsPlayingRootMotion()) return false;
+
+    if (bIdleAsleep)
+    {
+        // Teleported or moved by gameplay code
+        if (!UpdatedComponent->GetComponentLocation().Equals(SleepLocation))
+        {
+            return false;
+        }
+
+        // Standing on something that moved or changed
+        UPrimitiveComponent* Base = CharacterOwner->GetMovementBase();
+        if (Base != SleepBase.Get())
+        {
+            return false;
+        }
+        if (Base && !Base->GetComponentTransform().Equals(SleepBaseTransform))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void USarahMovementComponent::FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bCanUseCachedLocation, const FHitResult* DownwardSweepResult) const
+{
+    // Only where the stock check would sweep; landing checks bring their own sweep
+    const bool bWouldSweep = bAlwaysCheckFloor || !bCanUseCachedLocation;
+    if (bUsingAsyncFloorProbe && bFloorProbeValid && bWouldSweep && !DownwardSweepResult && !bForceNextFloorCheck && !bJustTeleported
+        && FindFloorFromAsyncProbe(CapsuleLocation, OutFloorResult))
+    {
+        INC_DWORD_STAT(STAT_SarahAsyncFloorChecks);
+        return;
+    }
+
+    Super::FindFloor(CapsuleLocation, OutFloorResult, bCanUseCachedLocation, DownwardSweepResult);
+}
+
+bool USarahMovementComponent::ShouldUseAsyncFloorProbe() const
+{
+    if (!bUseAsyncFloorProbe || !HasValidData()) return false;
+
+    // Player moves are replayed and corrected against the server, so they stay exact
+    if (CharacterOwner->GetLocalRole() != ROLE_Authority || CharacterOwner->IsPlayerControlled()) return false;
+
+    if (IsFalling()) return true;
+    if (!IsMovingOnGround()) return false;
+
+    // Walking: only where no player is close enough to see a floor one frame late
+    const FVector Location = UpdatedComponent->GetComponentLocation();
+    const float MinDistanceSq = FMath::Square(AsyncFloorProbeWalkingDistance);
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+        if (PlayerPawn && FVector::DistSquared(PlayerPawn->GetActorLocation(), Location) < MinDistanceSq)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void USarahMovementComponent::ReadAsyncFloorProbe()
+{
+    bFloorProbeValid = false;
+    bUsingAsyncFloorProbe = ShouldUseAsyncFloorProbe();
+
+    if (!FloorProbeHandle.IsValid()) return;
+
+    // The world only keeps last frame's results; an older handle reads as missing
+    FTraceDatum TraceData;
+    if (bUsingAsyncFloorProbe && GetWorld()->QueryTraceData(FloorProbeHandle, TraceData))
+    {
+        FloorProbeHit = TraceData.OutHits.Num() > 0 ? TraceData.OutHits[0] : FHitResult(1.0f);
+        bFloorProbeValid = true;
+    }
+    FloorProbeHandle = FTraceHandle();
+}
+
+void USarahMovementComponent::SubmitAsyncFloorProbe(float DeltaTime)
+{
+    if (!bUsingAsyncFloorProbe || !HasValidData()) return;
+
+    float PawnRadius, PawnHalfHeight;
+    CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(PawnRadius, PawnHalfHeight);
+
+    // Reach far enough below to cover where next frame's move ends up
+    FloorProbeLocation = UpdatedComponent->GetComponentLocation();
+    FloorProbeMode = MovementMode;
+    FloorProbeDistance = GetFloorSweepDistance() + FMath::Abs(Velocity.Z) * DeltaTime * 2.0f;
+
+    const float ShrinkHeight = (PawnHalfHeight - PawnRadius) * (1.0f - SarahFloorProbe::ShrinkScale);
+    const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(PawnRadius, PawnHalfHeight - ShrinkHeight);
+    const FVector End = FloorProbeLocation - FVector(0.0f, 0.0f, FloorProbeDistance + ShrinkHeight);
+
+    // Same channel and responses as the synchronous floor sweep
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SarahFloorProbe), false, CharacterOwner);
+    FCollisionResponseParams ResponseParam;
+    InitCollisionParams(QueryParams, ResponseParam);
+
+    FloorProbeHandle = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, FloorProbeLocation, End, FQuat::Identity,
+        UpdatedComponent->GetCollisionObjectType(), CapsuleShape, QueryParams, ResponseParam);
+}
+
+bool USarahMovementComponent::FindFloorFromAsyncProbe(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult) const
+{
+    if (MovementMode != FloorProbeMode) return false;
+
+    float PawnRadius, PawnHalfHeight;
+    CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(PawnRadius, PawnHalfHeight);
+    if (FVector::DistSquared2D(CapsuleLocation, FloorProbeLocation) > FMath::Square(PawnRadius * SarahFloorProbe::MaxDrift))
+    {
+        return false;
+    }
+
+    const float SweepDistance = GetFloorSweepDistance();
+    const float ShrinkHeight = (PawnHalfHeight - PawnRadius) * (1.0f - SarahFloorProbe::ShrinkScale);
+
+    // Positive when we have moved down since the probe
+    const float Drop = FloorProbeLocation.Z - CapsuleLocation.Z;
+
+    if (!FloorProbeHit.bBlockingHit)
+    {
+        // Nothing below last frame's location; conclusive only if the probe reached past our own sweep
+        if (SweepDistance + Drop > FloorProbeDistance) return false;
+
+        OutFloorResult.Clear();
+        return true;
+    }
+
+    // Penetration, edges, perching and steep surfaces need the full synchronous logic
+    if (FloorProbeHit.bStartPenetrating || !FloorProbeHit.IsValidBlockingHit() || !IsWalkable(FloorProbeHit)) return false;
+    if (!IsWithinEdgeTolerance(FloorProbeLocation, FloorProbeHit.ImpactPoint, PawnRadius) || ShouldComputePerchResult(FloorProbeHit)) return false;
+
+    // Floor distance from the probe, moved to where the capsule is now
+    const float FloorDist = FloorProbeHit.Time * (FloorProbeDistance + ShrinkHeight) - ShrinkHeight - Drop;
+    if (FloorDist < 0.0f) return false;
+
+    OutFloorResult.Clear();
+    OutFloorResult.SetFromSweep(FloorProbeHit, FloorDist, FloorDist <= SweepDistance);
+    return true;
+}
+
+float USarahMovementComponent::GetFloorSweepDistance() const
+{
+    // As FindFloor: a little extra reach while walking so height adjustment keeps the floor
+    const float HeightCheckAdjust = IsMovingOnGround() ? MAX_FLOOR_DIST + KINDA_SMALL_NUMBER : -MAX_FLOOR_DIST;
+    return FMath::Max(MAX_FLOOR_DIST, MaxStepHeight + HeightCheckAdjust);
+}
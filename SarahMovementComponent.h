@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "WorldCollision.h"
+#include "SarahMovementComponent.generated.h"
+
+// Character movement for Sarah. Owns actor yaw: the character only hands it a
+// desired facing, and rotation stops issuing transform updates once converged.
+// A settled, input-free character standing still on the ground skips the
+// walking update and floor find entirely until something disturbs it.
+// Opted-in AI Sarahs can answer floor checks from an async sweep batched on
+// the previous frame while airborne or far from every player.
+UCLASS()
+class SARAH_API USarahMovementComponent : public UCharacterMovementComponent
+{
+    GENERATED_BODY()
+
+public:
+    // InterpSpeed <= 0 snaps to the yaw on the next movement update
+    void SetDesiredFacingYaw(float Yaw, float InterpSpeed);
+
+    bool IsRotationAsleep() const { return bRotationAsleep; }
+
+    bool IsIdleAsleep() const { return bIdleAsleep; }
+
+    // This frame's floor checks may be answered by last frame's async sweep
+    bool IsUsingAsyncFloorProbe() const { return bUsingAsyncFloorProbe; }
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    // Yaw error in degrees below which rotation goes to sleep
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Rotation", meta = (ClampMin = "0.0"))
+    float RotationSleepTolerance = 0.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Idle")
+    bool bEnableIdleFastPath = true;
+
+    // Consecutive still frames required before the idle fast path kicks in
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Idle", meta = (ClampMin = "1", EditCondition = "bEnableIdleFastPath"))
+    int32 IdleSettleFrames = 4;
+
+    // Floor checks read an async sweep submitted after last frame's movement,
+    // for AI-driven Sarahs while falling or while walking far from players.
+    // Anything the stale sweep cannot answer falls back to the synchronous one.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Floor")
+    bool bUseAsyncFloorProbe = false;
+
+    // Walking Sarahs closer than this to any player pawn keep synchronous floor checks
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sarah|Floor", meta = (ClampMin = "0.0", EditCondition = "bUseAsyncFloorProbe"))
+    float AsyncFloorProbeWalkingDistance = 3000.0f;
+
+    virtual void FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bCanUseCachedLocation, const FHitResult* DownwardSweepResult = nullptr) const override;
+
+protected:
+    virtual void PhysicsRotation(float DeltaTime) override;
+
+private:
+    float DesiredFacingYaw = 0.0f;
+    float FacingInterpSpeed = 0.0f;
+    bool bHasFacingTarget = false;
+    bool bRotationAsleep = true;
+
+    bool CanSleepIdle() const;
+
+    int32 SettledFrameCount = 0;
+    bool bIdleAsleep = false;
+
+    // Where we fell asleep, to wake when teleported or when the base moves
+    FVector SleepLocation = FVector::ZeroVector;
+    TWeakObjectPtr<UPrimitiveComponent> SleepBase;
+    FTransform SleepBaseTransform;
+
+    bool ShouldUseAsyncFloorProbe() const;
+    void ReadAsyncFloorProbe();
+    void SubmitAsyncFloorProbe(float DeltaTime);
+    bool FindFloorFromAsyncProbe(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult) const;
+    float GetFloorSweepDistance() const;
+
+    // Async floor probe: submitted after movement, read back before the next one
+    FTraceHandle FloorProbeHandle;
+    FHitResult FloorProbeHit;
+    FVector FloorProbeLocation = FVector::ZeroVector;
+    float FloorProbeDistance = 0.0f;
+    TEnumAsByte<EMovementMode> FloorProbeMode = MOVE_None;
+    bool bFloorProbeValid = false;
+    bool bUsingAsyncFloorProbe = false;
+};
@@ -0,0 +1,200 @@
+#include "Sarah/SarahPoseDatabase.h"
+#include "Sarah/SarahCharacter.h"
+#include "Algo/Sort.h"
+#include "Animation/Skeleton.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sarah Pose Query"), STAT_SarahPoseQuery, STATGROUP_Sarah);
+
+#if WITH_EDITOR
+namespace SarahPoseDatabase
+{
+    // Walks the parent chain of the reference skeleton to get a component-space location
+    FVector GetComponentSpaceBoneLocation(const UAnimSequence* Sequence, const FReferenceSkeleton& RefSkeleton, int32 BoneIndex, double Time)
+    {
+        FTransform ComponentSpace = FTransform::Identity;
+        while (BoneIndex != INDEX_NONE)
+        {
+            FTransform Local;
+            Sequence->GetBoneTransform(Local, FSkeletonPoseBoneIndex(BoneIndex), Time, true);
+            ComponentSpace = ComponentSpace * Local;
+            BoneIndex = RefSkeleton.GetParentIndex(BoneIndex);
+        }
+        return ComponentSpace.GetLocation();
+    }
+}
+
+void USarahPoseDatabase::BuildDatabase()
+{
+    TArray<FSarahPoseFeature> RawFeatures;
+
+    const float SampleInterval = 1.0f / FMath::Max(SampleRate, 1.0f);
+
+    for (int32 SequenceIndex = 0; SequenceIndex < Sequences.Num(); ++SequenceIndex)
+    {
+        const UAnimSequence* Sequence = Sequences[SequenceIndex];
+        if (!Sequence || !Sequence->GetSkeleton()) continue;
+
+        const FReferenceSkeleton& RefSkeleton = Sequence->GetSkeleton()->GetReferenceSkeleton();
+        const int32 LeftFootIndex = RefSkeleton.FindBoneIndex(LeftFootBone);
+        const int32 RightFootIndex = RefSkeleton.FindBoneIndex(RightFootBone);
+
+        const float PlayLength = Sequence->GetPlayLength();
+        for (float Time = 0.0f; Time + SampleInterval <= PlayLength; Time += SampleInterval)
+        {
+            const FTransform RootDelta = Sequence->ExtractRootMotionFromRange(Time, Time + SampleInterval);
+
+            FSarahPoseFeature& Feature = RawFeatures.AddDefaulted_GetRef();
+            Feature.SequenceIndex = SequenceIndex;
+            Feature.Time = Time;
+            Feature.Values[0] = RootDelta.GetTranslation().Size2D() / SampleInterval;
+            Feature.Values[1] = RootDelta.GetRotation().Rotator().Yaw / SampleInterval;
+
+            if (LeftFootIndex != INDEX_NONE)
+            {
+                const FVector LeftFoot = SarahPoseDatabase::GetComponentSpaceBoneLocation(Sequence, RefSkeleton, LeftFootIndex, Time);
+                Feature.Values[2] = LeftFoot.X;
+                Feature.Values[3] = LeftFoot.Y;
+            }
+
+            if (RightFootIndex != INDEX_NONE)
+            {
+                const FVector RightFoot = SarahPoseDatabase::GetComponentSpaceBoneLocation(Sequence, RefSkeleton, RightFootIndex, Time);
+                Feature.Values[4] = RightFoot.X;
+                Feature.Values[5] = RightFoot.Y;
+            }
+        }
+    }
+
+    InitializeFeatures(MoveTemp(RawFeatures));
+    MarkPackageDirty();
+}
+#endif
+
+void USarahPoseDatabase::InitializeFeatures(TArray<FSarahPoseFeature>&& RawFeatures)
+{
+    Features = MoveTemp(RawFeatures);
+
+    // Normalize each feature to unit variance, then apply the group weights
+    const float Weights[SarahPoseFeatureCount] = { SpeedWeight, FacingWeight, FootWeight, FootWeight, FootWeight, FootWeight };
+    for (int32 Dimension = 0; Dimension < SarahPoseFeatureCount; ++Dimension)
+    {
+        double Sum = 0.0;
+        double SumSq = 0.0;
+        for (const FSarahPoseFeature& Feature : Features)
+        {
+            Sum += Feature.Values[Dimension];
+            SumSq += FMath::Square(Feature.Values[Dimension]);
+        }
+
+        const double Count = FMath::Max(Features.Num(), 1);
+        const double Mean = Sum / Count;
+        const double StdDev = FMath::Sqrt(FMath::Max(SumSq / Count - Mean * Mean, 0.0));
+
+        FeatureMean[Dimension] = static_cast<float>(Mean);
+        FeatureScale[Dimension] = StdDev > KINDA_SMALL_NUMBER ? Weights[Dimension] / static_cast<float>(StdDev) : 0.0f;
+
+        for (FSarahPoseFeature& Feature : Features)
+        {
+            Feature.Values[Dimension] = (Feature.Values[Dimension] - FeatureMean[Dimension]) * FeatureScale[Dimension];
+        }
+    }
+
+    BuildTree(0, Features.Num(), 0);
+}
+
+void USarahPoseDatabase::BuildTree(int32 Begin, int32 End, int32 Depth)
+{
+    if (End - Begin <= 1) return;
+
+    // Median split on the depth's axis; the median becomes the node
+    const int32 Axis = Depth % SarahPoseFeatureCount;
+    TArrayView<FSarahPoseFeature> Range(Features.GetData() + Begin, End - Begin);
+    Algo::Sort(Range, [Axis](const FSarahPoseFeature& A, const FSarahPoseFeature& B)
+    {
+        return A.Values[Axis] < B.Values[Axis];
+    });
+
+    const int32 Mid = Begin + (End - Begin) / 2;
+    BuildTree(Begin, Mid, Depth + 1);
+    BuildTree(Mid + 1, End, Depth + 1);
+}
+
+void USarahPoseDatabase::SearchTree(int32 Begin, int32 End, int32 Depth, const float* QueryValues, int32& BestIndex, float& BestDistanceSq, int32& NodesLeft) const
+{
+    if (Begin >= End || NodesLeft <= 0) return;
+    --NodesLeft;
+
+    const int32 Mid = Begin + (End - Begin) / 2;
+    const FSarahPoseFeature& Node = Features[Mid];
+
+    float DistanceSq = 0.0f;
+    for (int32 Dimension = 0; Dimension < SarahPoseFeatureCount; ++Dimension)
+    {
+        DistanceSq += FMath::Square(Node.Values[Dimension] - QueryValues[Dimension]);
+    }
+
+    if (DistanceSq < BestDistanceSq)
+    {
+        BestDistanceSq = DistanceSq;
+        BestIndex = Mid;
+    }
+
+    // Near side first, far side only if the split plane is closer than the best match
+    const int32 Axis = Depth % SarahPoseFeatureCount;
+    const float SplitDistance = QueryValues[Axis] - Node.Values[Axis];
+    if (SplitDistance < 0.0f)
+    {
+        SearchTree(Begin, Mid, Depth + 1, QueryValues, BestIndex, BestDistanceSq, NodesLeft);
+        if (FMath::Square(SplitDistance) < BestDistanceSq)
+        {
+            SearchTree(Mid + 1, End, Depth + 1, QueryValues, BestIndex, BestDistanceSq, NodesLeft);
+        }
+    }
+    else
+    {
+        SearchTree(Mid + 1, End, Depth + 1, QueryValues, BestIndex, BestDistanceSq, NodesLeft);
+        if (FMath::Square(SplitDistance) < BestDistanceSq)
+        {
+            SearchTree(Begin, Mid, Depth + 1, QueryValues, BestIndex, BestDistanceSq, NodesLeft);
+        }
+    }
+}
+
+void USarahPoseDatabase::NormalizeQuery(const FSarahPoseQuery& Query, float* OutValues) const
+{
+    const float RawValues[SarahPoseFeatureCount] =
+    {
+        Query.RootSpeed,
+        Query.FacingDelta,
+        static_cast<float>(Query.LeftFoot.X),
+        static_cast<float>(Query.LeftFoot.Y),
+        static_cast<float>(Query.RightFoot.X),
+        static_cast<float>(Query.RightFoot.Y)
+    };
+
+    for (int32 Dimension = 0; Dimension < SarahPoseFeatureCount; ++Dimension)
+    {
+        OutValues[Dimension] = (RawValues[Dimension] - FeatureMean[Dimension]) * FeatureScale[Dimension];
+    }
+}
+
+bool USarahPoseDatabase::FindBestPose(const FSarahPoseQuery& Query, UAnimSequence*& OutSequence, float& OutTime) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SarahPoseQuery);
+
+    if (Features.Num() == 0) return false;
+
+    float QueryValues[SarahPoseFeatureCount];
+    NormalizeQuery(Query, QueryValues);
+
+    int32 BestIndex = INDEX_NONE;
+    float BestDistanceSq = TNumericLimits<float>::Max();
+    int32 NodesLeft = MaxNodesPerQuery;
+    SearchTree(0, Features.Num(), 0, QueryValues, BestIndex, BestDistanceSq, NodesLeft);
+
+    if (BestIndex == INDEX_NONE || !Sequences.IsValidIndex(Features[BestIndex].SequenceIndex)) return false;
+
+    OutSequence = Sequences[Features[BestIndex].SequenceIndex];
+    OutTime = Features[BestIndex].Time;
+    return OutSequence != nullptr;
+}
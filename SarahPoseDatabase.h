@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Animation/AnimSequence.h"
+#include "SarahPoseDatabase.generated.h"
+
+// Feature layout: root speed, facing delta, left foot XY, right foot XY
+static constexpr int32 SarahPoseFeatureCount = 6;
+
+// One sampled frame of a locomotion sequence
+USTRUCT()
+struct FSarahPoseFeature
+{
+    GENERATED_BODY()
+
+    // Normalized and weighted feature values
+    UPROPERTY()
+    float Values[SarahPoseFeatureCount] = { 0.0f };
+
+    UPROPERTY()
+    int32 SequenceIndex = INDEX_NONE;
+
+    UPROPERTY()
+    float Time = 0.0f;
+};
+
+// What the state machine wants to match, in the same units as the build
+struct FSarahPoseQuery
+{
+    // cm/s
+    float RootSpeed = 0.0f;
+
+    // deg/s of yaw change towards the target direction
+    float FacingDelta = 0.0f;
+
+    // Component-space foot positions of the current pose
+    FVector2D LeftFoot = FVector2D::ZeroVector;
+    FVector2D RightFoot = FVector2D::ZeroVector;
+};
+
+// Precomputed motion-matching database for Sarah's locomotion clips. Built in
+// the editor from Sequences; frames are stored flat in implicit KD-tree order.
+UCLASS(BlueprintType)
+class SARAH_API USarahPoseDatabase : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, Category = "Sarah|PoseDatabase")
+    TArray<UAnimSequence*> Sequences;
+
+    UPROPERTY(EditAnywhere, Category = "Sarah|PoseDatabase")
+    FName LeftFootBone = TEXT("foot_l");
+
+    UPROPERTY(EditAnywhere, Category = "Sarah|PoseDatabase")
+    FName RightFootBone = TEXT("foot_r");
+
+    UPROPERTY(EditAnywhere, Category = "Sarah|PoseDatabase", meta = (ClampMin = "1.0"))
+    float SampleRate = 30.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Sarah|PoseDatabase", meta = (ClampMin = "0.0"))
+    float SpeedWeight = 1.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Sarah|PoseDatabase", meta = (ClampMin = "0.0"))
+    float FacingWeight = 1.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Sarah|PoseDatabase", meta = (ClampMin = "0.0"))
+    float FootWeight = 0.5f;
+
+    // Fixed per-query budget: tree nodes visited before returning the best so far
+    UPROPERTY(EditAnywhere, Category = "Sarah|PoseDatabase", meta = (ClampMin = "1"))
+    int32 MaxNodesPerQuery = 256;
+
+#if WITH_EDITOR
+    UFUNCTION(CallInEditor, Category = "Sarah|PoseDatabase")
+    void BuildDatabase();
+#endif
+
+    // Takes unnormalized feature values, then normalizes, weights and builds the tree.
+    // BuildDatabase feeds it the sampled frames of Sequences.
+    void InitializeFeatures(TArray<FSarahPoseFeature>&& RawFeatures);
+
+    bool FindBestPose(const FSarahPoseQuery& Query, UAnimSequence*& OutSequence, float& OutTime) const;
+
+    int32 GetNumPoses() const { return Features.Num(); }
+
+private:
+    void BuildTree(int32 Begin, int32 End, int32 Depth);
+    void SearchTree(int32 Begin, int32 End, int32 Depth, const float* QueryValues, int32& BestIndex, float& BestDistanceSq, int32& NodesLeft) const;
+    void NormalizeQuery(const FSarahPoseQuery& Query, float* OutValues) const;
+
+    UPROPERTY()
+    TArray<FSarahPoseFeature> Features;
+
+    // Per-feature normalization baked at build time: (Value - Mean) * Scale
+    UPROPERTY()
+    float FeatureMean[SarahPoseFeatureCount] = { 0.0f };
+
+    UPROPERTY()
+    float FeatureScale[SarahPoseFeatureCount] = { 0.0f };
+};
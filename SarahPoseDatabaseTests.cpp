@@ -0,0 +1,127 @@
+#include "Sarah/SarahPoseDatabase.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SarahPoseDatabaseTests
+{
+    static FSarahPoseQuery MakeQuery(const float* Values)
+    {
+        FSarahPoseQuery Query;
+        Query.RootSpeed = Values[0];
+        Query.FacingDelta = Values[1];
+        Query.LeftFoot = FVector2D(Values[2], Values[3]);
+        Query.RightFoot = FVector2D(Values[4], Values[5]);
+        return Query;
+    }
+
+    static void RandomValues(FRandomStream& Random, float* OutValues)
+    {
+        OutValues[0] = Random.FRandRange(0.0f, 600.0f);
+        OutValues[1] = Random.FRandRange(-180.0f, 180.0f);
+        for (int32 Dimension = 2; Dimension < SarahPoseFeatureCount; ++Dimension)
+        {
+            OutValues[Dimension] = Random.FRandRange(-50.0f, 50.0f);
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSarahPoseDatabaseSearchTest, "Sarah.Animation.PoseDatabaseSearch",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSarahPoseDatabaseSearchTest::RunTest(const FString& Parameters)
+{
+    using namespace SarahPoseDatabaseTests;
+
+    USarahPoseDatabase* Database = NewObject<USarahPoseDatabase>();
+    UAnimSequence* Sequence = nullptr;
+    float Time = 0.0f;
+    TestFalse(TEXT("Empty database finds nothing"), Database->FindBestPose(FSarahPoseQuery(), Sequence, Time));
+
+    constexpr int32 NumSequences = 4;
+    constexpr int32 NumPoses = 600;
+    for (int32 Index = 0; Index < NumSequences; ++Index)
+    {
+        Database->Sequences.Add(NewObject<UAnimSequence>());
+    }
+
+    // Time doubles as the pose id
+    FRandomStream Random(1234);
+    TArray<FSarahPoseFeature> RawFeatures;
+    for (int32 Index = 0; Index < NumPoses; ++Index)
+    {
+        FSarahPoseFeature& Feature = RawFeatures.AddDefaulted_GetRef();
+        RandomValues(Random, Feature.Values);
+        Feature.SequenceIndex = Index % NumSequences;
+        Feature.Time = static_cast<float>(Index);
+    }
+    const TArray<FSarahPoseFeature> Poses = RawFeatures;
+
+    Database->MaxNodesPerQuery = NumPoses;
+    Database->InitializeFeatures(MoveTemp(RawFeatures));
+    TestEqual(TEXT("Pose count"), Database->GetNumPoses(), NumPoses);
+
+    // Every stored pose finds itself
+    int32 ExactMisses = 0;
+    for (const FSarahPoseFeature& Pose : Poses)
+    {
+        if (!Database->FindBestPose(MakeQuery(Pose.Values), Sequence, Time) || Time != Pose.Time || Sequence != Database->Sequences[Pose.SequenceIndex])
+        {
+            ++ExactMisses;
+        }
+    }
+    TestEqual(TEXT("Stored poses found exactly"), ExactMisses, 0);
+
+    // Same normalization and weights as the database, searched by brute force
+    const float Weights[SarahPoseFeatureCount] = { Database->SpeedWeight, Database->FacingWeight,
+        Database->FootWeight, Database->FootWeight, Database->FootWeight, Database->FootWeight };
+    float Scale[SarahPoseFeatureCount];
+    for (int32 Dimension = 0; Dimension < SarahPoseFeatureCount; ++Dimension)
+    {
+        double Sum = 0.0;
+        double SumSq = 0.0;
+        for (const FSarahPoseFeature& Pose : Poses)
+        {
+            Sum += Pose.Values[Dimension];
+            SumSq += FMath::Square(Pose.Values[Dimension]);
+        }
+        const double Mean = Sum / NumPoses;
+        Scale[Dimension] = Weights[Dimension] / static_cast<float>(FMath::Sqrt(SumSq / NumPoses - Mean * Mean));
+    }
+
+    int32 NearestMisses = 0;
+    for (int32 QueryIndex = 0; QueryIndex < 200; ++QueryIndex)
+    {
+        float QueryValues[SarahPoseFeatureCount];
+        RandomValues(Random, QueryValues);
+
+        float BestDistanceSq = TNumericLimits<float>::Max();
+        float BestTime = -1.0f;
+        for (const FSarahPoseFeature& Pose : Poses)
+        {
+            float DistanceSq = 0.0f;
+            for (int32 Dimension = 0; Dimension < SarahPoseFeatureCount; ++Dimension)
+            {
+                DistanceSq += FMath::Square((Pose.Values[Dimension] - QueryValues[Dimension]) * Scale[Dimension]);
+            }
+            if (DistanceSq < BestDistanceSq)
+            {
+                BestDistanceSq = DistanceSq;
+                BestTime = Pose.Time;
+            }
+        }
+
+        if (!Database->FindBestPose(MakeQuery(QueryValues), Sequence, Time) || Time != BestTime)
+        {
+            ++NearestMisses;
+        }
+    }
+    TestEqual(TEXT("KD-tree matches brute force with an unlimited budget"), NearestMisses, 0);
+
+    // A budget of one node still answers with the root
+    Database->MaxNodesPerQuery = 1;
+    TestTrue(TEXT("Smallest budget still returns a pose"), Database->FindBestPose(MakeQuery(Poses[0].Values), Sequence, Time));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,59 @@
+#include "Sarah/SarahSpringArmComponent.h"
+#include "Sarah/SarahCharacter.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sarah Camera Probe"), STAT_SarahCameraProbe, STATGROUP_Sarah);
+
+void USarahSpringArmComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+    UWorld* World = GetWorld();
+    if (!bUseAsyncProbe || !bDoTrace || !World)
+    {
+        Super::UpdateDesiredArmLocation(bDoTrace, bDoLocationLag, bDoRotationLag, DeltaTime);
+        return;
+    }
+
+    // Place the arm with the stock lag logic but without its synchronous sweep
+    Super::UpdateDesiredArmLocation(false, bDoLocationLag, bDoRotationLag, DeltaTime);
+
+    SCOPE_CYCLE_COUNTER(STAT_SarahCameraProbe);
+
+    // Read back the sweep issued last frame
+    if (PendingProbe.IsValid())
+    {
+        FTraceDatum TraceData;
+        if (World->QueryTraceData(PendingProbe, TraceData))
+        {
+            PreviousProbeFraction = ProbeFraction;
+            ProbeFraction = (TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit) ? TraceData.OutHits[0].Time : 1.0f;
+        }
+        PendingProbe = FTraceHandle();
+    }
+
+    // Extrapolate one frame to cover the probe latency, never past the measurement
+    const float PredictedFraction = FMath::Clamp(ProbeFraction + (ProbeFraction - PreviousProbeFraction), 0.0f, 1.0f);
+    const float TargetFraction = FMath::Min(ProbeFraction, PredictedFraction);
+
+    // Pull in immediately, ease back out
+    SmoothedFraction = TargetFraction < SmoothedFraction
+        ? TargetFraction
+        : FMath::FInterpTo(SmoothedFraction, TargetFraction, DeltaTime, AsyncProbeRecoverySpeed);
+
+    const FVector ArmOrigin = PreviousArmOrigin;
+    const FVector DesiredSocket = GetComponentTransform().TransformPosition(RelativeSocketLocation);
+
+    bIsCameraFixed = SmoothedFraction < 1.0f;
+    UnfixedCameraPosition = DesiredSocket;
+
+    if (bIsCameraFixed)
+    {
+        const FVector ResultSocket = ArmOrigin + (DesiredSocket - ArmOrigin) * SmoothedFraction;
+        RelativeSocketLocation = GetComponentTransform().InverseTransformPosition(ResultSocket);
+        UpdateChildTransforms();
+    }
+
+    // Issue next frame's probe; it runs with the world's async trace batch
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SpringArm), false, GetOwner());
+    PendingProbe = World->AsyncSweepByChannel(EAsyncTraceType::Single, ArmOrigin, DesiredSocket, FQuat::Identity,
+        ProbeChannel, FCollisionShape::MakeSphere(ProbeSize), QueryParams);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "WorldCollision.h"
+#include "SarahSpringArmComponent.generated.h"
+
+// Spring arm whose collision probe can run as an async sweep. The arm uses the
+// previous frame's result, so collision reacts one frame late. To keep that
+// bounded, the arm pulls in immediately to the smaller of the measured and
+// one-frame-extrapolated hit fraction. It eases back out at
+// AsyncProbeRecoverySpeed, so any extra penetration versus the synchronous
+// probe is at most one frame of camera motion.
+UCLASS(ClassGroup = Camera, meta = (BlueprintSpawnableComponent))
+class SARAH_API USarahSpringArmComponent : public USpringArmComponent
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CameraCollision", meta = (EditCondition = "bDoCollisionTest"))
+    bool bUseAsyncProbe = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CameraCollision", meta = (ClampMin = "0.0", EditCondition = "bUseAsyncProbe"))
+    float AsyncProbeRecoverySpeed = 10.0f;
+
+protected:
+    virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+private:
+    FTraceHandle PendingProbe;
+
+    // Hit fractions along the arm, 1 means unobstructed
+    float ProbeFraction = 1.0f;
+    float PreviousProbeFraction = 1.0f;
+    float SmoothedFraction = 1.0f;
+};
@@ -0,0 +1,61 @@
+#include "Sarah/SarahStateEventSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sarah Batched State Events"), STAT_SarahBatchedStateEvents, STATGROUP_Sarah);
+
+FSarahStateChangeEvent& USarahStateEventSubsystem::FindOrAddPending(ASarahCharacter* Character)
+{
+    if (const int32* Index = PendingIndices.Find(Character))
+    {
+        return Pending[*Index];
+    }
+
+    PendingIndices.Add(Character, Pending.Num());
+    FSarahStateChangeEvent& Event = Pending.AddDefaulted_GetRef();
+    Event.Character = Character;
+    Event.PreviousState = Character->GetSarahMovementState();
+    Event.NewState = Event.PreviousState;
+    Event.bIsSprinting = Character->GetSarahIsSprinting();
+    return Event;
+}
+
+void USarahStateEventSubsystem::QueueStateChange(ASarahCharacter* Character, ESarahMovementState PreviousState, ESarahMovementState NewState)
+{
+    FSarahStateChangeEvent& Event = FindOrAddPending(Character);
+
+    // Keep the state the frame started in, not the one just left
+    if (Event.StateChangeCount == 0)
+    {
+        Event.PreviousState = PreviousState;
+    }
+    Event.NewState = NewState;
+    ++Event.StateChangeCount;
+}
+
+void USarahStateEventSubsystem::QueueSprintChange(ASarahCharacter* Character, bool bIsSprinting)
+{
+    FSarahStateChangeEvent& Event = FindOrAddPending(Character);
+    Event.bSprintChanged = true;
+    Event.bIsSprinting = bIsSprinting;
+}
+
+void USarahStateEventSubsystem::Tick(float DeltaTime)
+{
+    if (Pending.Num() == 0)
+    {
+        return;
+    }
+
+    INC_DWORD_STAT_BY(STAT_SarahBatchedStateEvents, Pending.Num());
+
+    // Listeners may change state while handling the batch; those land in the next frame
+    Swap(Pending, Broadcasting);
+    PendingIndices.Reset();
+
+    OnSarahStateChangesBatched.Broadcast(Broadcasting);
+    Broadcasting.Reset();
+}
+
+TStatId USarahStateEventSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USarahStateEventSubsystem, STATGROUP_Tickables);
+}
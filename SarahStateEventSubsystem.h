@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Sarah/SarahCharacter.h"
+#include "SarahStateEventSubsystem.generated.h"
+
+// Net change of one Sarah over a frame. Several transitions in the same frame
+// collapse into one entry: PreviousState is where the frame started.
+USTRUCT(BlueprintType)
+struct FSarahStateChangeEvent
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "SarahFSM")
+    ASarahCharacter* Character = nullptr;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SarahFSM")
+    ESarahMovementState PreviousState = ESarahMovementState::Idle;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SarahFSM")
+    ESarahMovementState NewState = ESarahMovementState::Idle;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SarahFSM")
+    int32 StateChangeCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SarahFSM")
+    bool bSprintChanged = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SarahFSM")
+    bool bIsSprinting = false;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSarahStateChangesBatchSignature, const TArray<FSarahStateChangeEvent>&, Changes);
+
+// Collects state and sprint changes from Sarahs with bBatchStateEvents set and
+// broadcasts them once per frame, so listeners need neither a tick nor one binding per character.
+UCLASS()
+class SARAH_API USarahStateEventSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintAssignable, Category = "SarahFSM")
+    FSarahStateChangesBatchSignature OnSarahStateChangesBatched;
+
+    void QueueStateChange(ASarahCharacter* Character, ESarahMovementState PreviousState, ESarahMovementState NewState);
+    void QueueSprintChange(ASarahCharacter* Character, bool bIsSprinting);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    FSarahStateChangeEvent& FindOrAddPending(ASarahCharacter* Character);
+
+    TArray<FSarahStateChangeEvent> Pending;
+    TArray<FSarahStateChangeEvent> Broadcasting;
+    TMap<const ASarahCharacter*, int32> PendingIndices;
+};
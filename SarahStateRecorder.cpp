@@ -0,0 +1,47 @@
+#include "Sarah/SarahStateRecorder.h"
+
+void USarahStateRecorder::Watch(ASarahCharacter* Character)
+{
+    StopWatching();
+    Edges.Reset();
+
+    if (Character)
+    {
+        Character->OnSarahMovementStateChanged.AddDynamic(this, &USarahStateRecorder::HandleStateChanged);
+        Watched = Character;
+    }
+}
+
+void USarahStateRecorder::StopWatching()
+{
+    if (ASarahCharacter* Character = Watched.Get())
+    {
+        Character->OnSarahMovementStateChanged.RemoveDynamic(this, &USarahStateRecorder::HandleStateChanged);
+    }
+    Watched.Reset();
+}
+
+FString USarahStateRecorder::DescribeEdges() const
+{
+    return DescribeEdges(Edges);
+}
+
+FString USarahStateRecorder::DescribeEdges(const TArray<FSarahStateEdge>& InEdges)
+{
+    const UEnum* StateEnum = StaticEnum<ESarahMovementState>();
+
+    FString Result;
+    for (const FSarahStateEdge& Edge : InEdges)
+    {
+        if (!Result.IsEmpty()) Result += TEXT(", ");
+        Result += StateEnum->GetNameStringByValue(static_cast<int64>(Edge.From));
+        Result += TEXT(" -> ");
+        Result += StateEnum->GetNameStringByValue(static_cast<int64>(Edge.To));
+    }
+    return Result;
+}
+
+void USarahStateRecorder::HandleStateChanged(ASarahCharacter* Character, ESarahMovementState PreviousState, ESarahMovementState NewState)
+{
+    Edges.Add({ PreviousState, NewState });
+}
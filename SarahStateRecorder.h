@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Sarah/SarahCharacter.h"
+#include "SarahStateRecorder.generated.h"
+
+// One transition as OnSarahMovementStateChanged reported it
+struct FSarahStateEdge
+{
+    ESarahMovementState From;
+    ESarahMovementState To;
+};
+
+// Records every state edge of one Sarah, in the order they are broadcast,
+// including transitions chained from Enter logic. Used by the automation tests.
+UCLASS()
+class SARAH_API USarahStateRecorder : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    void Watch(ASarahCharacter* Character);
+    void StopWatching();
+
+    const TArray<FSarahStateEdge>& GetEdges() const { return Edges; }
+
+    // "Idle -> Walk, Walk -> Run"
+    FString DescribeEdges() const;
+    static FString DescribeEdges(const TArray<FSarahStateEdge>& InEdges);
+
+private:
+    UFUNCTION()
+    void HandleStateChanged(ASarahCharacter* Character, ESarahMovementState PreviousState, ESarahMovementState NewState);
+
+    TWeakObjectPtr<ASarahCharacter> Watched;
+    TArray<FSarahStateEdge> Edges;
+};
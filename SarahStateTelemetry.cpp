@@ -0,0 +1,362 @@
+#include "Sarah/SarahStateTelemetry.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogSarahTelemetry, Log, All);
+
+static TAutoConsoleVariable<int32> CVarSarahTelemetryEnable(
+    TEXT("sarah.Telemetry.Enable"),
+    0,
+    TEXT("Record every Sarah FSM transition and write it to Saved/Telemetry as CSV."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSarahTelemetryCapacity(
+    TEXT("sarah.Telemetry.Capacity"),
+    65536,
+    TEXT("Ring buffer size in records. Read when recording starts."),
+    ECVF_Default);
+
+static FAutoConsoleCommand CmdSarahTelemetryFlush(
+    TEXT("sarah.Telemetry.Flush"),
+    TEXT("Write all pending Sarah telemetry records to disk."),
+    FConsoleCommandDelegate::CreateStatic(&FSarahStateTelemetry::Flush));
+
+namespace SarahTelemetry
+{
+    // Ring buffer and a staging copy of the same size, both allocated once
+    TArray<FSarahStateTelemetryRecord> Ring;
+    TArray<FSarahStateTelemetryRecord> Staging;
+    uint64 Head = 0;
+    uint64 FlushedUpTo = 0;
+    uint64 DroppedRecords = 0;
+
+    FString FilePath;
+    std::atomic<bool> bWriteInFlight { false };
+    bool bRegisteredShutdownFlush = false;
+
+    void Initialize()
+    {
+        // Nothing else flushes a ring that never fills up
+        if (!bRegisteredShutdownFlush)
+        {
+            FWorldDelegates::OnWorldCleanup.AddLambda([](UWorld*, bool, bool) { FSarahStateTelemetry::FlushAndWait(); });
+            FCoreDelegates::OnPreExit.AddStatic(&FSarahStateTelemetry::FlushAndWait);
+            bRegisteredShutdownFlush = true;
+        }
+
+        const int32 Capacity = FMath::Max(CVarSarahTelemetryCapacity.GetValueOnGameThread(), 1024);
+        Ring.SetNumUninitialized(Capacity);
+        Staging.SetNumUninitialized(Capacity);
+        Head = 0;
+        FlushedUpTo = 0;
+        DroppedRecords = 0;
+
+        FilePath = FPaths::ProjectSavedDir() / TEXT("Telemetry") /
+            FString::Printf(TEXT("SarahStates-%s.csv"), *FDateTime::Now().ToString());
+        FFileHelper::SaveStringToFile(TEXT("Timestamp,CharacterId,From,To,Speed,MovementAngle\n"), *FilePath);
+
+        UE_LOG(LogSarahTelemetry, Log, TEXT("Recording Sarah state telemetry to %s"), *FilePath);
+    }
+
+    void WriteStaging(int32 Count)
+    {
+        FString Lines;
+        Lines.Reserve(Count * 48);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const FSarahStateTelemetryRecord& Record = Staging[Index];
+            Lines += FString::Printf(TEXT("%.4f,%u,%d,%d,%.1f,%.1f\n"),
+                Record.Timestamp,
+                Record.CharacterId,
+                static_cast<int32>(Record.FromState),
+                static_cast<int32>(Record.ToState),
+                Record.Speed,
+                Record.MovementAngle);
+        }
+
+        FFileHelper::SaveStringToFile(Lines, *FilePath, FFileHelper::EEncodingOptions::AutoDetect,
+            &IFileManager::Get(), FILEWRITE_Append);
+    }
+
+    // Moves unflushed records into Staging; caller owns bWriteInFlight
+    int32 StagePending()
+    {
+        const uint64 Capacity = Ring.Num();
+        const int32 Count = static_cast<int32>(Head - FlushedUpTo);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Staging[Index] = Ring[(FlushedUpTo + Index) % Capacity];
+        }
+        FlushedUpTo = Head;
+
+        if (DroppedRecords > 0)
+        {
+            UE_LOG(LogSarahTelemetry, Warning, TEXT("Dropped %llu telemetry records, raise sarah.Telemetry.Capacity"), DroppedRecords);
+            DroppedRecords = 0;
+        }
+        return Count;
+    }
+}
+
+bool FSarahStateTelemetry::IsEnabled()
+{
+    return CVarSarahTelemetryEnable.GetValueOnGameThread() != 0;
+}
+
+void FSarahStateTelemetry::Record(const FSarahStateTelemetryRecord& Record)
+{
+    using namespace SarahTelemetry;
+
+    if (Ring.Num() == 0)
+    {
+        Initialize();
+    }
+
+    const uint64 Capacity = Ring.Num();
+    if (Head - FlushedUpTo >= Capacity)
+    {
+        // Writer fell behind, overwrite the oldest unflushed record
+        ++FlushedUpTo;
+        ++DroppedRecords;
+    }
+
+    Ring[Head % Capacity] = Record;
+    ++Head;
+
+    if (Head - FlushedUpTo >= Capacity / 2)
+    {
+        Flush();
+    }
+}
+
+void FSarahStateTelemetry::Flush()
+{
+    using namespace SarahTelemetry;
+
+    if (Ring.Num() == 0 || Head == FlushedUpTo)
+    {
+        return;
+    }
+
+    // Only one background write at a time; the staging buffer is reused
+    bool bExpected = false;
+    if (!bWriteInFlight.compare_exchange_strong(bExpected, true))
+    {
+        return;
+    }
+
+    const int32 Count = StagePending();
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Count]()
+    {
+        WriteStaging(Count);
+        bWriteInFlight = false;
+    });
+}
+
+void FSarahStateTelemetry::FlushAndWait()
+{
+    using namespace SarahTelemetry;
+
+    if (Ring.Num() == 0)
+    {
+        return;
+    }
+
+    // Let a background write finish, then write the remainder on this thread
+    bool bExpected = false;
+    while (!bWriteInFlight.compare_exchange_strong(bExpected, true))
+    {
+        bExpected = false;
+        FPlatformProcess::SleepNoStats(0.001f);
+    }
+
+    if (Head != FlushedUpTo)
+    {
+        WriteStaging(StagePending());
+    }
+    bWriteInFlight = false;
+}
+
+USarahTelemetryAnalyzeCommandlet::USarahTelemetryAnalyzeCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+void USarahTelemetryAnalyzeCommandlet::Analyze(const TArray<FString>& Lines, const TArray<float>& Buckets, float ThrashWindow, FSarahTelemetryReport& OutReport)
+{
+    const int32 NumStates = StaticEnum<ESarahMovementState>()->NumEnums() - 1;
+
+    // Per-character timeline: entry time of the current state and the last two transitions
+    struct FCharacterTrack
+    {
+        double StateEnterTime = -1.0;
+        int32 State = -1;
+        int32 LastFrom = -1;
+        double LastTransitionTime = -1.0;
+    };
+
+    TMap<uint32, FCharacterTrack> Tracks;
+    TArray<TArray<int32>>& DwellHistogram = OutReport.DwellHistogram;
+    DwellHistogram.Reset();
+    DwellHistogram.SetNum(NumStates);
+    for (TArray<int32>& Histogram : DwellHistogram)
+    {
+        Histogram.SetNumZeroed(Buckets.Num() + 1);
+    }
+
+    TArray<int32>& TransitionCounts = OutReport.TransitionCounts;
+    TransitionCounts.Reset();
+    TransitionCounts.SetNumZeroed(NumStates * NumStates);
+
+    int32 ThrashCount = 0;
+    int32 RecordCount = 0;
+    double FirstTimestamp = TNumericLimits<double>::Max();
+    double LastTimestamp = TNumericLimits<double>::Lowest();
+
+    const int32 WalkIndex = static_cast<int32>(ESarahMovementState::Walk);
+    const int32 RunIndex = static_cast<int32>(ESarahMovementState::Run);
+
+    // Skip header
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        TArray<FString> Fields;
+        if (Lines[LineIndex].ParseIntoArray(Fields, TEXT(",")) < 6)
+        {
+            continue;
+        }
+
+        const double Timestamp = FCString::Atod(*Fields[0]);
+        const uint32 CharacterId = static_cast<uint32>(FCString::Strtoui64(*Fields[1], nullptr, 10));
+        const int32 From = FCString::Atoi(*Fields[2]);
+        const int32 To = FCString::Atoi(*Fields[3]);
+        if (From < 0 || From >= NumStates || To < 0 || To >= NumStates)
+        {
+            continue;
+        }
+
+        ++RecordCount;
+        FirstTimestamp = FMath::Min(FirstTimestamp, Timestamp);
+        LastTimestamp = FMath::Max(LastTimestamp, Timestamp);
+        ++TransitionCounts[From * NumStates + To];
+
+        FCharacterTrack& Track = Tracks.FindOrAdd(CharacterId);
+
+        // Dwell time of the state being left
+        if (Track.State == From && Track.StateEnterTime >= 0.0)
+        {
+            const double Dwell = Timestamp - Track.StateEnterTime;
+            int32 Bucket = 0;
+            while (Bucket < Buckets.Num() && Dwell > Buckets[Bucket])
+            {
+                ++Bucket;
+            }
+            ++DwellHistogram[From][Bucket];
+        }
+
+        // Walk->Run->Walk or Run->Walk->Run inside the window
+        const bool bWalkRunPair = (From == WalkIndex && To == RunIndex) || (From == RunIndex && To == WalkIndex);
+        if (bWalkRunPair && Track.LastFrom == To && (Timestamp - Track.LastTransitionTime) <= ThrashWindow)
+        {
+            ++ThrashCount;
+        }
+
+        Track.State = To;
+        Track.StateEnterTime = Timestamp;
+        Track.LastFrom = From;
+        Track.LastTransitionTime = Timestamp;
+    }
+
+    OutReport.RecordCount = RecordCount;
+    OutReport.CharacterCount = Tracks.Num();
+    OutReport.ThrashCount = ThrashCount;
+    OutReport.Duration = FMath::Max(LastTimestamp - FirstTimestamp, 1e-3);
+}
+
+int32 USarahTelemetryAnalyzeCommandlet::Main(const FString& Params)
+{
+    FString FilePath;
+    if (!FParse::Value(*Params, TEXT("File="), FilePath))
+    {
+        UE_LOG(LogSarahTelemetry, Error, TEXT("Usage: -run=SarahTelemetryAnalyze -File=<csv> [-ThrashWindow=0.5] [-Buckets=0.25,0.5,1,2,5]"));
+        return 1;
+    }
+
+    float ThrashWindow = 0.5f;
+    FParse::Value(*Params, TEXT("ThrashWindow="), ThrashWindow);
+
+    TArray<float> Buckets = { 0.25f, 0.5f, 1.0f, 2.0f, 5.0f };
+    FString BucketsParam;
+    if (FParse::Value(*Params, TEXT("Buckets="), BucketsParam, false))
+    {
+        TArray<FString> Parts;
+        BucketsParam.ParseIntoArray(Parts, TEXT(","));
+        Buckets.Reset();
+        for (const FString& Part : Parts)
+        {
+            Buckets.Add(FCString::Atof(*Part));
+        }
+        Buckets.Sort();
+    }
+
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath) || Lines.Num() < 2)
+    {
+        UE_LOG(LogSarahTelemetry, Error, TEXT("No telemetry records in %s"), *FilePath);
+        return 1;
+    }
+
+    FSarahTelemetryReport Report;
+    Analyze(Lines, Buckets, ThrashWindow, Report);
+
+    const UEnum* StateEnum = StaticEnum<ESarahMovementState>();
+    const int32 NumStates = Report.DwellHistogram.Num();
+    const double Duration = Report.Duration;
+
+    UE_LOG(LogSarahTelemetry, Display, TEXT("%d transitions from %d characters over %.1fs"), Report.RecordCount, Report.CharacterCount, Duration);
+
+    UE_LOG(LogSarahTelemetry, Display, TEXT("Dwell time histograms (upper bounds in seconds):"));
+    for (int32 State = 0; State < NumStates; ++State)
+    {
+        FString Row;
+        for (int32 Bucket = 0; Bucket <= Buckets.Num(); ++Bucket)
+        {
+            if (Bucket < Buckets.Num())
+            {
+                Row += FString::Printf(TEXT(" <=%.2f:%d"), Buckets[Bucket], Report.DwellHistogram[State][Bucket]);
+            }
+            else
+            {
+                Row += FString::Printf(TEXT(" >%.2f:%d"), Buckets.Num() > 0 ? Buckets.Last() : 0.0f, Report.DwellHistogram[State][Bucket]);
+            }
+        }
+        UE_LOG(LogSarahTelemetry, Display, TEXT("  %-8s%s"), *StateEnum->GetNameStringByIndex(State), *Row);
+    }
+
+    UE_LOG(LogSarahTelemetry, Display, TEXT("Transition rates (per second, all characters):"));
+    for (int32 From = 0; From < NumStates; ++From)
+    {
+        for (int32 To = 0; To < NumStates; ++To)
+        {
+            const int32 Count = Report.TransitionCounts[From * NumStates + To];
+            if (Count > 0)
+            {
+                UE_LOG(LogSarahTelemetry, Display, TEXT("  %s -> %s: %d (%.2f/s)"),
+                    *StateEnum->GetNameStringByIndex(From), *StateEnum->GetNameStringByIndex(To), Count, Count / Duration);
+            }
+        }
+    }
+
+    UE_LOG(LogSarahTelemetry, Display, TEXT("Walk<->Run thrash within %.2fs: %d"), ThrashWindow, Report.ThrashCount);
+    return 0;
+}
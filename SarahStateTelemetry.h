@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Sarah/SarahCharacter.h"
+#include "SarahStateTelemetry.generated.h"
+
+// One ChangeState call, as written to the telemetry file
+struct FSarahStateTelemetryRecord
+{
+    double Timestamp;
+    uint32 CharacterId;
+    ESarahMovementState FromState;
+    ESarahMovementState ToState;
+    float Speed;
+    float MovementAngle;
+};
+
+// Low-overhead recorder for FSM transitions. Records go into a preallocated
+// ring buffer on the game thread and are written to CSV on a background thread.
+class SARAH_API FSarahStateTelemetry
+{
+public:
+    static bool IsEnabled();
+
+    // Game thread only
+    static void Record(const FSarahStateTelemetryRecord& Record);
+
+    // Hands everything recorded so far to the background writer
+    static void Flush();
+
+    // Blocks until every record is on disk; runs at world cleanup and engine exit
+    static void FlushAndWait();
+};
+
+// What USarahTelemetryAnalyzeCommandlet reports for one telemetry file
+struct FSarahTelemetryReport
+{
+    int32 RecordCount = 0;
+    int32 CharacterCount = 0;
+    double Duration = 0.0;
+    int32 ThrashCount = 0;
+
+    // [State][Bucket], one more bucket than bounds for the overflow
+    TArray<TArray<int32>> DwellHistogram;
+
+    // [From * NumStates + To]
+    TArray<int32> TransitionCounts;
+};
+
+// Offline analyzer for telemetry files:
+// -run=SarahTelemetryAnalyze -File=<csv> [-ThrashWindow=0.5] [-Buckets=0.25,0.5,1,2,5]
+UCLASS()
+class SARAH_API USarahTelemetryAnalyzeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USarahTelemetryAnalyzeCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+    // Lines of a telemetry CSV, header first; Buckets sorted ascending
+    static void Analyze(const TArray<FString>& Lines, const TArray<float>& Buckets, float ThrashWindow, FSarahTelemetryReport& OutReport);
+};
@@ -0,0 +1,54 @@
+#include "Sarah/SarahStateTelemetry.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSarahTelemetryAnalyzeTest, "Sarah.Telemetry.Analyze",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSarahTelemetryAnalyzeTest::RunTest(const FString& Parameters)
+{
+    // States: 0 Idle, 1 Walk, 2 Run, 3 Jump, 4 Landing
+    const TArray<FString> Lines = {
+        TEXT("Timestamp,CharacterId,From,To,Speed,MovementAngle"),
+        TEXT("0.0000,1,0,1,0.0,90.0"),
+        TEXT("0.2000,1,1,2,200.0,90.0"),
+        TEXT("0.4000,1,2,1,600.0,90.0"),
+        TEXT("1.4000,1,1,0,200.0,90.0"),
+        TEXT("0.1000,2,0,3,0.0,0.0"),
+        TEXT("0.9000,2,3,4,0.0,0.0"),
+        TEXT("garbage"),
+        TEXT("1.0000,2,0,9,0.0,0.0"),
+    };
+    const TArray<float> Buckets = { 0.25f, 0.5f, 1.0f };
+
+    FSarahTelemetryReport Report;
+    USarahTelemetryAnalyzeCommandlet::Analyze(Lines, Buckets, 0.5f, Report);
+
+    TestEqual(TEXT("Valid records"), Report.RecordCount, 6);
+    TestEqual(TEXT("Characters"), Report.CharacterCount, 2);
+    TestEqual(TEXT("Duration"), Report.Duration, 1.4, 1e-4);
+
+    // Walk->Run->Walk inside 0.5s
+    TestEqual(TEXT("Thrash count"), Report.ThrashCount, 1);
+
+    const int32 NumStates = Report.DwellHistogram.Num();
+    TestEqual(TEXT("Idle -> Walk"), Report.TransitionCounts[0 * NumStates + 1], 1);
+    TestEqual(TEXT("Walk -> Run"), Report.TransitionCounts[1 * NumStates + 2], 1);
+    TestEqual(TEXT("Run -> Walk"), Report.TransitionCounts[2 * NumStates + 1], 1);
+    TestEqual(TEXT("Jump -> Landing"), Report.TransitionCounts[3 * NumStates + 4], 1);
+
+    TestEqual(TEXT("Walk dwell <= 0.25s"), Report.DwellHistogram[1][0], 1);
+    TestEqual(TEXT("Walk dwell <= 1s"), Report.DwellHistogram[1][2], 1);
+    TestEqual(TEXT("Run dwell <= 0.25s"), Report.DwellHistogram[2][0], 1);
+    TestEqual(TEXT("Jump dwell <= 1s"), Report.DwellHistogram[3][2], 1);
+    TestEqual(TEXT("Idle has no complete dwell"), Report.DwellHistogram[0][0] + Report.DwellHistogram[0][3], 0);
+
+    // Same swap outside the window is not thrash
+    FSarahTelemetryReport SlowReport;
+    USarahTelemetryAnalyzeCommandlet::Analyze(Lines, Buckets, 0.1f, SlowReport);
+    TestEqual(TEXT("Thrash count with a 0.1s window"), SlowReport.ThrashCount, 0);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
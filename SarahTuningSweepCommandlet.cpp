@@ -0,0 +1,342 @@
+#include "Sarah/SarahTuningSweepCommandlet.h"
+#include "Sarah/SarahCharacter.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSarahTuning, Log, All);
+
+namespace SarahTuning
+{
+    struct FTraceSample
+    {
+        float DeltaTime;
+        FVector2D MoveInput;
+        bool bSprint;
+        float CameraYaw;
+    };
+
+    struct FParams
+    {
+        float ContinuousRotationSpeed;
+        float RotationInterpSpeed;
+        float WalkSpeed;
+        float RunSpeed;
+    };
+
+    struct FMetrics
+    {
+        int32 Turns = 0;
+        int32 SettledTurns = 0;
+        float TotalSettleTime = 0.0f;
+        float MaxSettleTime = 0.0f;
+        float TotalOvershoot = 0.0f;
+        float MaxOvershoot = 0.0f;
+        int32 Transitions = 0;
+        float Distance = 0.0f;
+    };
+
+    // Min:Max:Steps, or a single value
+    static bool ParseRange(const FString& Params, const TCHAR* Name, float Default, TArray<float>& OutValues)
+    {
+        OutValues.Reset();
+
+        FString Spec;
+        if (!FParse::Value(*Params, *FString::Printf(TEXT("%s="), Name), Spec, false))
+        {
+            OutValues.Add(Default);
+            return true;
+        }
+
+        TArray<FString> Parts;
+        Spec.ParseIntoArray(Parts, TEXT(":"));
+        if (Parts.Num() == 1)
+        {
+            OutValues.Add(FCString::Atof(*Parts[0]));
+            return true;
+        }
+        if (Parts.Num() != 3)
+        {
+            UE_LOG(LogSarahTuning, Error, TEXT("-%s expects Min:Max:Steps, got %s"), Name, *Spec);
+            return false;
+        }
+
+        const float Min = FCString::Atof(*Parts[0]);
+        const float Max = FCString::Atof(*Parts[1]);
+        const int32 Steps = FMath::Max(1, FCString::Atoi(*Parts[2]));
+        for (int32 Step = 0; Step < Steps; ++Step)
+        {
+            const float Alpha = Steps > 1 ? (float)Step / (Steps - 1) : 0.0f;
+            OutValues.Add(FMath::Lerp(Min, Max, Alpha));
+        }
+        return true;
+    }
+
+    static bool LoadTrace(const FString& FilePath, TArray<FTraceSample>& OutSamples)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+        {
+            return false;
+        }
+
+        TArray<FString> Fields;
+        for (const FString& Line : Lines)
+        {
+            Fields.Reset();
+            Line.ParseIntoArray(Fields, TEXT(","));
+
+            // Skips the header and anything malformed
+            if (Fields.Num() < 4 || !Fields[0].IsNumeric())
+            {
+                continue;
+            }
+
+            FTraceSample& Sample = OutSamples.AddDefaulted_GetRef();
+            Sample.DeltaTime = FCString::Atof(*Fields[0]);
+            Sample.MoveInput = FVector2D(FCString::Atof(*Fields[1]), FCString::Atof(*Fields[2]));
+            Sample.bSprint = FCString::Atoi(*Fields[3]) != 0;
+            Sample.CameraYaw = Fields.Num() > 4 ? FCString::Atof(*Fields[4]) : 0.0f;
+        }
+        return OutSamples.Num() > 0;
+    }
+
+    // Mirrors ASarahCharacter::UpdateMovement and the locomotion FSM for one trace
+    static void SimulateTrace(const TArray<FTraceSample>& Samples, const FParams& Params,
+        float TurnThreshold, float SettleTolerance, FMetrics& Metrics)
+    {
+        ESarahMovementState State = ESarahMovementState::Idle;
+        float MovementAngle = 0.0f;
+        float Yaw = 0.0f;
+        float LockedYaw = 0.0f;
+        bool bMoving = false;
+
+        bool bTurning = false;
+        float TurnTarget = 0.0f;
+        float TurnTime = 0.0f;
+        float TurnSign = 0.0f;
+        float TurnOvershoot = 0.0f;
+
+        for (const FTraceSample& Sample : Samples)
+        {
+            const float DeltaTime = Sample.DeltaTime;
+            const bool bHasInput = ASarahCharacter::IsMoveInputActive(Sample.MoveInput);
+
+            if (bHasInput)
+            {
+                // Camera-relative movement locks the camera yaw when leaving Idle
+                if (!bMoving)
+                {
+                    LockedYaw = Sample.CameraYaw;
+                    MovementAngle = LockedYaw;
+                    bMoving = true;
+                }
+
+                // Input stays relative to the locked yaw while the camera moves
+                const float TargetAngle = ASarahCharacter::InputToWorldAngle(Sample.MoveInput, LockedYaw);
+                ASarahCharacter::StepContinuousAngle(MovementAngle, TargetAngle, Params.ContinuousRotationSpeed, DeltaTime);
+                Yaw = FMath::RInterpTo(FRotator(0.0f, Yaw, 0.0f), FRotator(0.0f, MovementAngle, 0.0f), DeltaTime, Params.RotationInterpSpeed).Yaw;
+
+                // A new turn starts whenever the requested direction jumps
+                if (!bTurning || FMath::Abs(ASarahCharacter::FindShortestAnglePath(TurnTarget, TargetAngle)) > TurnThreshold)
+                {
+                    const float Error = ASarahCharacter::FindShortestAnglePath(Yaw, TargetAngle);
+                    if (FMath::Abs(Error) > TurnThreshold)
+                    {
+                        if (bTurning)
+                        {
+                            Metrics.TotalOvershoot += TurnOvershoot;
+                        }
+                        bTurning = true;
+                        TurnTarget = TargetAngle;
+                        TurnTime = 0.0f;
+                        TurnSign = FMath::Sign(Error);
+                        TurnOvershoot = 0.0f;
+                        ++Metrics.Turns;
+                    }
+                }
+
+                if (bTurning)
+                {
+                    TurnTime += DeltaTime;
+                    const float Error = ASarahCharacter::FindShortestAnglePath(Yaw, TurnTarget);
+
+                    // Facing has swung past the target
+                    if (FMath::Sign(Error) == -TurnSign)
+                    {
+                        TurnOvershoot = FMath::Max(TurnOvershoot, FMath::Abs(Error));
+                        Metrics.MaxOvershoot = FMath::Max(Metrics.MaxOvershoot, TurnOvershoot);
+                    }
+
+                    if (FMath::Abs(Error) <= SettleTolerance)
+                    {
+                        ++Metrics.SettledTurns;
+                        Metrics.TotalSettleTime += TurnTime;
+                        Metrics.MaxSettleTime = FMath::Max(Metrics.MaxSettleTime, TurnTime);
+                        Metrics.TotalOvershoot += TurnOvershoot;
+                        bTurning = false;
+                    }
+                }
+            }
+            else
+            {
+                bMoving = false;
+                if (bTurning)
+                {
+                    Metrics.TotalOvershoot += TurnOvershoot;
+                    bTurning = false;
+                }
+            }
+
+            const ESarahMovementState NextState = ASarahCharacter::GetLocomotionTransition(State, bHasInput, Sample.bSprint);
+            if (NextState != State)
+            {
+                State = NextState;
+                ++Metrics.Transitions;
+            }
+
+            const float Speed = State == ESarahMovementState::Run ? Params.RunSpeed
+                : State == ESarahMovementState::Walk ? Params.WalkSpeed : 0.0f;
+            Metrics.Distance += Speed * DeltaTime;
+        }
+
+        if (bTurning)
+        {
+            Metrics.TotalOvershoot += TurnOvershoot;
+        }
+    }
+}
+
+USarahTuningSweepCommandlet::USarahTuningSweepCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 USarahTuningSweepCommandlet::Main(const FString& Params)
+{
+    using namespace SarahTuning;
+
+    FString TracesPath;
+    if (!FParse::Value(*Params, TEXT("Traces="), TracesPath))
+    {
+        UE_LOG(LogSarahTuning, Error, TEXT("Usage: -run=SarahTuningSweep -Traces=<csv or directory> [-Out=<csv>] [-ContinuousRotationSpeed=Min:Max:Steps] [-RotationInterpSpeed=Min:Max:Steps] [-WalkSpeed=Min:Max:Steps] [-RunSpeed=Min:Max:Steps]"));
+        return 1;
+    }
+
+    TArray<FString> TraceFiles;
+    if (IFileManager::Get().DirectoryExists(*TracesPath))
+    {
+        IFileManager::Get().FindFiles(TraceFiles, *FPaths::Combine(TracesPath, TEXT("*.csv")), true, false);
+        for (FString& File : TraceFiles)
+        {
+            File = FPaths::Combine(TracesPath, File);
+        }
+    }
+    else
+    {
+        TraceFiles.Add(TracesPath);
+    }
+
+    TArray<TArray<FTraceSample>> Traces;
+    for (const FString& File : TraceFiles)
+    {
+        TArray<FTraceSample> Samples;
+        if (LoadTrace(File, Samples))
+        {
+            Traces.Add(MoveTemp(Samples));
+        }
+        else
+        {
+            UE_LOG(LogSarahTuning, Warning, TEXT("Skipping %s: no samples"), *File);
+        }
+    }
+
+    if (Traces.Num() == 0)
+    {
+        UE_LOG(LogSarahTuning, Error, TEXT("No input traces in %s"), *TracesPath);
+        return 1;
+    }
+
+    // Axes default to the character's tuned values
+    const ASarahCharacter* Defaults = GetDefault<ASarahCharacter>();
+    TArray<float> RotationSpeeds, InterpSpeeds, WalkSpeeds, RunSpeeds;
+    if (!ParseRange(Params, TEXT("ContinuousRotationSpeed"), Defaults->ContinuousRotationSpeed, RotationSpeeds) ||
+        !ParseRange(Params, TEXT("RotationInterpSpeed"), Defaults->RotationInterpSpeed, InterpSpeeds) ||
+        !ParseRange(Params, TEXT("WalkSpeed"), Defaults->WalkSpeed, WalkSpeeds) ||
+        !ParseRange(Params, TEXT("RunSpeed"), Defaults->RunSpeed, RunSpeeds))
+    {
+        return 1;
+    }
+
+    float TurnThreshold = 30.0f;
+    float SettleTolerance = 2.0f;
+    FParse::Value(*Params, TEXT("TurnThreshold="), TurnThreshold);
+    FParse::Value(*Params, TEXT("SettleTolerance="), SettleTolerance);
+
+    TArray<FParams> Grid;
+    Grid.Reserve(RotationSpeeds.Num() * InterpSpeeds.Num() * WalkSpeeds.Num() * RunSpeeds.Num());
+    for (float RotationSpeed : RotationSpeeds)
+    {
+        for (float InterpSpeed : InterpSpeeds)
+        {
+            for (float WalkSpeed : WalkSpeeds)
+            {
+                for (float RunSpeed : RunSpeeds)
+                {
+                    Grid.Add({ RotationSpeed, InterpSpeed, WalkSpeed, RunSpeed });
+                }
+            }
+        }
+    }
+
+    // Grid points are independent; the task graph steals work across all cores
+    const double StartTime = FPlatformTime::Seconds();
+    TArray<FMetrics> Results;
+    Results.SetNum(Grid.Num());
+    ParallelFor(Grid.Num(), [&](int32 Index)
+    {
+        for (const TArray<FTraceSample>& Trace : Traces)
+        {
+            SimulateTrace(Trace, Grid[Index], TurnThreshold, SettleTolerance, Results[Index]);
+        }
+    });
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+    FString Csv = TEXT("ContinuousRotationSpeed,RotationInterpSpeed,WalkSpeed,RunSpeed,Turns,SettledTurns,MeanSettleTime,MaxSettleTime,MeanOvershoot,MaxOvershoot,Transitions,Distance\n");
+    for (int32 Index = 0; Index < Grid.Num(); ++Index)
+    {
+        const FParams& Point = Grid[Index];
+        const FMetrics& Metrics = Results[Index];
+        Csv += FString::Printf(TEXT("%.3f,%.3f,%.1f,%.1f,%d,%d,%.4f,%.4f,%.3f,%.3f,%d,%.1f\n"),
+            Point.ContinuousRotationSpeed, Point.RotationInterpSpeed, Point.WalkSpeed, Point.RunSpeed,
+            Metrics.Turns, Metrics.SettledTurns,
+            Metrics.SettledTurns > 0 ? Metrics.TotalSettleTime / Metrics.SettledTurns : 0.0f,
+            Metrics.MaxSettleTime,
+            Metrics.Turns > 0 ? Metrics.TotalOvershoot / Metrics.Turns : 0.0f,
+            Metrics.MaxOvershoot,
+            Metrics.Transitions, Metrics.Distance);
+    }
+
+    FString OutPath;
+    if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+    {
+        OutPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Tuning"),
+            FString::Printf(TEXT("SarahSweep_%s.csv"), *FDateTime::Now().ToString()));
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+    {
+        UE_LOG(LogSarahTuning, Error, TEXT("Could not write %s"), *OutPath);
+        return 1;
+    }
+
+    UE_LOG(LogSarahTuning, Display, TEXT("Swept %d parameter sets over %d traces in %.2fs -> %s"),
+        Grid.Num(), Traces.Num(), Elapsed, *OutPath);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SarahTuningSweepCommandlet.generated.h"
+
+// Headless parameter sweep over recorded input traces. Each trace is a CSV of
+// DeltaTime,MoveX,MoveY,Sprint[,CameraYaw] rows; every grid point replays all
+// traces through the Sarah angle, rotation and FSM math and reports one CSV row.
+// -run=SarahTuningSweep -Traces=<csv or directory> [-Out=<csv>]
+//     [-ContinuousRotationSpeed=Min:Max:Steps] [-RotationInterpSpeed=Min:Max:Steps]
+//     [-WalkSpeed=Min:Max:Steps] [-RunSpeed=Min:Max:Steps]
+//     [-TurnThreshold=30] [-SettleTolerance=2]
+UCLASS()
+class SARAH_API USarahTuningSweepCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USarahTuningSweepCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};